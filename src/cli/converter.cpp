@@ -0,0 +1,63 @@
+#include <converter.h>
+
+#include <importer/dxf/importer.h>
+
+#include <common/exception.h>
+
+namespace cli
+{
+
+void Converter::applyOperation(model::Task &task) const
+{
+	switch (m_operation) {
+		case Operation::None:
+		{
+			break;
+		}
+		case Operation::LeftCutterCompensation:
+		case Operation::RightCutterCompensation:
+		{
+			const float scale = (m_operation == Operation::LeftCutterCompensation) ? 1.0f : -1.0f;
+			const float scaledRadius = m_toolRadius * scale;
+
+			task.forEachPath([this, scaledRadius](model::Path &path){
+				path.offset(scaledRadius, m_dxf.minimumPolylineLength, m_dxf.minimumArcLength);
+			});
+			break;
+		}
+		case Operation::PocketAll:
+		{
+			task.pocketAll(m_toolRadius, m_dxf.minimumPolylineLength, m_dxf.minimumArcLength);
+			break;
+		}
+	}
+}
+
+Converter::Converter(model::Application &application, Operation operation)
+	:m_toolConfig(application.defaultToolConfig()),
+	m_profileConfig(application.defaultProfileConfig()),
+	m_dxf(application.config().root().import().dxf().snapshot()),
+	m_pathSettings(application.defaultPathSettings()),
+	m_toolRadius(m_toolConfig.general().radius()),
+	m_operation(operation),
+	m_exporter(m_toolConfig, m_profileConfig, exporter::gcode::Exporter::ExportConfig)
+{
+}
+
+void Converter::operator()(const std::string &inputFileName, const std::string &outputFileName) const
+{
+	importer::dxf::Importer importer(inputFileName, m_dxf.splineToArcPrecision, m_dxf.minimumSplineLength, m_dxf.minimumArcLength);
+
+	// Qt objects of the document belong to the calling thread.
+	model::Document document(model::Application::CreateTaskFromDxfImporter(importer, m_dxf, m_pathSettings), m_toolConfig, m_profileConfig);
+	applyOperation(document.task());
+
+	std::ofstream output(outputFileName);
+	if (!output) {
+		throw common::FileCouldNotOpenException();
+	}
+
+	m_exporter(document, output);
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <model/application.h>
+
+#include <exporter/gcode/exporter.h>
+
+namespace cli
+{
+
+/** @brief Convert dxf files to gcode without user interface.
+ * Configuration is captured at construction so files can be converted concurrently.
+ */
+class Converter
+{
+public:
+	enum class Operation
+	{
+		None,
+		LeftCutterCompensation,
+		RightCutterCompensation,
+		PocketAll
+	};
+
+private:
+	const config::Tools::Tool &m_toolConfig;
+	const config::Profiles::Profile &m_profileConfig;
+	const config::Import::Dxf::Snapshot m_dxf;
+	const model::PathSettings m_pathSettings;
+	const float m_toolRadius;
+	const Operation m_operation;
+	const exporter::gcode::Exporter m_exporter;
+
+	void applyOperation(model::Task &task) const;
+
+public:
+	/// @throw common::GCodeFormatException if a profile gcode format is invalid
+	explicit Converter(model::Application &application, Operation operation);
+
+	/** Import, process and export one file, safe to call concurrently.
+	 * @throw common::FileCouldNotOpenException if input or output file can't be opened
+	 */
+	void operator()(const std::string &inputFileName, const std::string &outputFileName) const;
+};
+
+}
@@ -0,0 +1,139 @@
+#include <cli/converter.h>
+
+#include <common/exception.h>
+#include <common/parallel.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QDebug>
+
+#include <thread>
+
+/// Output file in outputDirectory or aside input file when empty
+static QString outputFileName(const QString &inputFileName, const QString &outputDirectory)
+{
+	const QFileInfo fileInfo(inputFileName);
+	const QDir dir = outputDirectory.isEmpty() ? fileInfo.absoluteDir() : QDir(outputDirectory);
+
+	return dir.filePath(fileInfo.completeBaseName() + model::Application::FileExtension::Gcode);
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication qapp(argc, argv);
+	qapp.setApplicationName("dxfplotter");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(QCoreApplication::translate("main", "Convert dxf files to gcode"));
+	parser.addHelpOption();
+	parser.addPositionalArgument("files", "input dxf files", "files...");
+
+	QCommandLineOption toolOption("t", QCoreApplication::translate("main", "Select tool"),
+		QCoreApplication::translate("main", "tool"));
+	parser.addOption(toolOption);
+
+	QCommandLineOption profileOption("p", QCoreApplication::translate("main", "Select profile"),
+		QCoreApplication::translate("main", "profile"));
+	parser.addOption(profileOption);
+
+	QCommandLineOption jobsOption({"j", "jobs"}, QCoreApplication::translate("main", "Number of files converted concurrently"),
+		QCoreApplication::translate("main", "count"), QString::number(std::max(1u, std::thread::hardware_concurrency())));
+	parser.addOption(jobsOption);
+
+	QCommandLineOption outputOption({"o", "output-directory"}, QCoreApplication::translate("main", "Directory of gcode files, default to input file directory"),
+		QCoreApplication::translate("main", "directory"));
+	parser.addOption(outputOption);
+
+	QCommandLineOption leftOption("left", QCoreApplication::translate("main", "Apply left cutter compensation to all paths"));
+	parser.addOption(leftOption);
+
+	QCommandLineOption rightOption("right", QCoreApplication::translate("main", "Apply right cutter compensation to all paths"));
+	parser.addOption(rightOption);
+
+	QCommandLineOption pocketOption("pocket", QCoreApplication::translate("main", "Pocket all closed paths"));
+	parser.addOption(pocketOption);
+
+	parser.process(qapp);
+
+	const QStringList fileNames = parser.positionalArguments();
+	if (fileNames.isEmpty()) {
+		parser.showHelp(1);
+	}
+
+	bool validJobs;
+	const uint jobs = parser.value(jobsOption).toUInt(&validJobs);
+	if (!validJobs || jobs == 0) {
+		qCritical() << "Invalid job count" << parser.value(jobsOption);
+		return 1;
+	}
+
+	if ((parser.isSet(leftOption) + parser.isSet(rightOption) + parser.isSet(pocketOption)) > 1) {
+		qCritical() << "Only one of left, right and pocket operations can be selected";
+		return 1;
+	}
+
+	cli::Converter::Operation operation = cli::Converter::Operation::None;
+	if (parser.isSet(leftOption)) {
+		operation = cli::Converter::Operation::LeftCutterCompensation;
+	}
+	else if (parser.isSet(rightOption)) {
+		operation = cli::Converter::Operation::RightCutterCompensation;
+	}
+	else if (parser.isSet(pocketOption)) {
+		operation = cli::Converter::Operation::PocketAll;
+	}
+
+	model::Application app;
+
+	if (parser.isSet(toolOption) && !app.selectTool(parser.value(toolOption))) {
+		qCritical() << "Invalid tool name" << parser.value(toolOption);
+		return 1;
+	}
+
+	if (parser.isSet(profileOption) && !app.selectProfile(parser.value(profileOption))) {
+		qCritical() << "Invalid profile name" << parser.value(profileOption);
+		return 1;
+	}
+
+	const QString outputDirectory = parser.value(outputOption);
+	if (!outputDirectory.isEmpty()) {
+		QDir().mkpath(outputDirectory);
+	}
+
+	try {
+		const cli::Converter converter(app, operation);
+
+		// Every job reports its own failure, others keep running.
+		std::atomic<int> failureCount = 0;
+		common::parallelFor(fileNames.size(), jobs, [&](size_t index){
+			const QString &inputFileName = fileNames[index];
+			const QString gcodeFileName = outputFileName(inputFileName, outputDirectory);
+
+			try {
+				converter(inputFileName.toStdString(), gcodeFileName.toStdString());
+				qInfo() << "Converted" << inputFileName << "to" << gcodeFileName;
+			}
+			catch (const common::FileCouldNotOpenException&) {
+				qCritical() << "Could not open" << inputFileName << "or" << gcodeFileName;
+				++failureCount;
+			}
+			catch (const std::exception &exception) {
+				qCritical() << "Failed to convert" << inputFileName << ":" << exception.what();
+				++failureCount;
+			}
+		});
+
+		if (failureCount > 0) {
+			qCritical() << failureCount << "of" << fileNames.size() << "files failed";
+			return 1;
+		}
+	}
+	catch (const std::exception &exception) {
+		qCritical() << exception.what();
+		return 1;
+	}
+
+	return 0;
+}
@@ -41,4 +41,12 @@ class ImportCouldNotFindProfileConfigException : public std::exception
 {
 };
 
+class ImportUnsupportedFormatVersionException : public std::exception
+{
+};
+
+class ImportCorruptedFileException : public std::exception
+{
+};
+
 }
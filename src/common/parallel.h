@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace common
+{
+
+namespace internal
+{
+
+/// True on threads currently running a parallelFor body
+inline thread_local bool insideParallelFor = false;
+
+/** @brief Threads kept alive between parallel loops, created on first use.
+ * One thread less than hardware threads, the thread calling a loop works as well.
+ */
+class ThreadPool
+{
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<std::function<void ()>> m_tasks;
+	std::vector<std::thread> m_threads;
+	bool m_stopping = false;
+
+	void run()
+	{
+		while (true) {
+			std::function<void ()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this](){ return m_stopping || !m_tasks.empty(); });
+				if (m_tasks.empty()) {
+					return;
+				}
+
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	explicit ThreadPool(size_t threadCount)
+	{
+		m_threads.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i) {
+			m_threads.emplace_back([this](){ run(); });
+		}
+	}
+
+public:
+	~ThreadPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_condition.notify_all();
+
+		for (std::thread &thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	static ThreadPool &instance()
+	{
+		static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+		return pool;
+	}
+
+	size_t threadCount() const
+	{
+		return m_threads.size();
+	}
+
+	/// Run task on a pool thread, task must not throw
+	void post(std::function<void ()> &&task)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(std::move(task));
+		}
+		m_condition.notify_one();
+	}
+};
+
+/** @brief Indices of a loop dispatched to its workers. Shared with pool tasks which may
+ * start once all indices are done, they then leave without calling functor.
+ */
+template <class Functor>
+class ParallelLoop
+{
+private:
+	Functor &m_functor;
+	const size_t m_size;
+	std::atomic<size_t> m_nextIndex = 0;
+	/// Indices not yet done, skipped indices after a failure included
+	std::atomic<size_t> m_remaining;
+	std::atomic<bool> m_failed = false;
+	std::exception_ptr m_exception;
+	std::mutex m_mutex;
+	std::condition_variable m_done;
+
+public:
+	explicit ParallelLoop(Functor &functor, size_t size)
+		:m_functor(functor),
+		m_size(size),
+		m_remaining(size)
+	{
+	}
+
+	void work()
+	{
+		insideParallelFor = true;
+
+		for (size_t index = m_nextIndex++; index < m_size; index = m_nextIndex++) {
+			if (!m_failed) {
+				try {
+					m_functor(index);
+				}
+				catch (...) {
+					const std::lock_guard<std::mutex> lock(m_mutex);
+					if (!m_exception) {
+						m_exception = std::current_exception();
+					}
+					m_failed = true;
+				}
+			}
+
+			if (--m_remaining == 0) {
+				const std::lock_guard<std::mutex> lock(m_mutex);
+				m_done.notify_all();
+			}
+		}
+
+		insideParallelFor = false;
+	}
+
+	/// Wait all indices done and rethrow first exception thrown by functor
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this](){ return m_remaining == 0; });
+
+		if (m_exception) {
+			std::rethrow_exception(m_exception);
+		}
+	}
+};
+
+}
+
+/** @brief Call functor(index) for every index in [0, size) using at most maxWorkerCount threads.
+ * Workers are the calling thread and threads of a pool kept between calls, limited to hardware threads.
+ * Indices are dispatched dynamically so unbalanced work is spread over workers.
+ * A call nested in a parallel body runs sequentially to avoid thread oversubscription.
+ * The first exception thrown by functor is rethrown once all indices are done.
+ */
+template <class Functor>
+void parallelFor(size_t size, size_t maxWorkerCount, Functor &&functor)
+{
+	const size_t workerCount = std::min(std::max<size_t>(1, maxWorkerCount), size);
+
+	if (workerCount <= 1 || internal::insideParallelFor) {
+		for (size_t index = 0; index < size; ++index) {
+			functor(index);
+		}
+		return;
+	}
+
+	using Loop = internal::ParallelLoop<std::remove_reference_t<Functor>>;
+	const std::shared_ptr<Loop> loop = std::make_shared<Loop>(functor, size);
+
+	internal::ThreadPool &pool = internal::ThreadPool::instance();
+	const size_t helperCount = std::min(workerCount - 1, pool.threadCount());
+	for (size_t i = 0; i < helperCount; ++i) {
+		pool.post([loop](){ loop->work(); });
+	}
+	// Calling thread participates as well
+	loop->work();
+
+	loop->wait();
+}
+
+/// Call functor(index) for every index in [0, size) using one worker per hardware thread
+template <class Functor>
+void parallelFor(size_t size, Functor &&functor)
+{
+	parallelFor(size, std::thread::hardware_concurrency(), std::forward<Functor>(functor));
+}
+
+}
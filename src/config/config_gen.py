@@ -34,6 +34,8 @@ class Group(Node):
 		self.children = children
 
 		self.tuple_name = ", ".join(map(lambda p: p.unique_class_name, children))
+		# Plain value type holding a copy of the group values
+		self.snapshot_type = "{}::Snapshot".format(self.class_name)
 
 
 class List(Node):
@@ -41,6 +43,7 @@ class List(Node):
 		super().__init__(name)
 
 		self.item = item
+		self.snapshot_type = "{}::Snapshot".format(self.class_name)
 
 
 class Property(Node):
@@ -57,6 +60,7 @@ class Property(Node):
 
 		self.class_name = "Property<{}>".format(self.base_type)
 		self.unique_class_name = self.class_name
+		self.snapshot_type = self.base_type
 
 
 def load_from_node(xml_node, nodes):
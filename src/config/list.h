@@ -19,6 +19,9 @@ private:
 	YAML::Node m_yamlNode;
 
 public:
+	/// Immutable copy of all items values indexed by name
+	using Snapshot = std::map<std::string, typename Child::Snapshot>;
+
 	explicit List(const std::string& name, const std::string &description, const YAML::Node &yamlNode)
 		:Node(name, description),
 		m_yamlNode(yamlNode)
@@ -72,6 +75,16 @@ public:
 		return m_children.begin()->second;
 	}
 
+	Snapshot snapshot() const
+	{
+		Snapshot snapshot;
+		for (const auto &[name, child] : m_children) {
+			snapshot.emplace(name, child.snapshot());
+		}
+
+		return snapshot;
+	}
+
 	template <class Visitor>
 	void visitChildren(Visitor &&visitor)
 	{
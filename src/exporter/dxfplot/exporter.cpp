@@ -1,18 +1,23 @@
 #include <exporter.h>
 
+#include <serializer/chunks.h>
+#include <serializer/format.h>
 #include <serializer/task.h>
 
 #include <cereal/cereal.hpp>
+#include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
 
 namespace exporter::dxfplot
 {
 
-void Exporter::operator()(const model::Document& document, std::ostream &output)  const
+Exporter::Exporter(Format format)
+	:m_format(format)
 {
-	Archive archive(output);
-	save(archive, document);
 }
 
+template <class Archive>
 void Exporter::save(Archive &archive, const model::Document& document) const
 {
 	archive(cereal::make_nvp("task", document.task()));
@@ -20,4 +25,35 @@ void Exporter::save(Archive &archive, const model::Document& document) const
 	archive(cereal::make_nvp("tool_name", document.toolConfig().name()));
 }
 
+void Exporter::operator()(const model::Document& document, std::ostream &output)  const
+{
+	switch (m_format) {
+		case Format::Json:
+		{
+			cereal::JSONOutputArchive archive(output);
+			save(archive, document);
+			break;
+		}
+		case Format::Binary:
+		{
+			output.write(serializer::BinaryMagic.data(), serializer::BinaryMagic.size());
+			{
+				cereal::PortableBinaryOutputArchive archive(output);
+				archive(serializer::BinaryVersion);
+			}
+
+			// Table of contents followed by geometry region of base polylines
+			serializer::ChunkWriter writer;
+			{
+				cereal::UserDataAdapter<serializer::ChunkWriter, cereal::PortableBinaryOutputArchive> archive(writer, output);
+				save(archive, document);
+			}
+
+			const std::string region = writer.region();
+			output.write(region.data(), region.size());
+			break;
+		}
+	}
+}
+
 }
@@ -2,8 +2,6 @@
 
 #include <model/document.h>
 
-#include <cereal/archives/json.hpp>
-
 #include <fstream>
 
 namespace exporter::dxfplot
@@ -12,13 +10,22 @@ namespace exporter::dxfplot
 class Exporter
 {
 public:
-	explicit Exporter() = default;
+	enum class Format
+	{
+		/// Human readable, used for interchange
+		Json,
+		/// Portable binary with magic header, fast to save and loaded lazily
+		Binary
+	};
+
+	explicit Exporter(Format format = Format::Json);
 
 	void operator()(const model::Document& document, std::ostream &output)  const;
 
 private:
-	using Archive = cereal::JSONOutputArchive;
+	Format m_format;
 
+	template <class Archive>
 	void save(Archive &archive, const model::Document& document) const;
 };
 
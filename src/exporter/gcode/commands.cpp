@@ -0,0 +1,18 @@
+#include <commands.h>
+
+namespace exporter::gcode
+{
+
+Commands::Commands(const config::Profiles::Profile::Gcode::Snapshot &gcode)
+	:preCut(gcode.preCut, {"S"}),
+	postCut(gcode.postCut, {}),
+	planeLinearMove(gcode.planeLinearMove, {"X", "Y", "F", "S"}),
+	planeFastMove(gcode.planeFastMove, {"X", "Y"}),
+	depthLinearMove(gcode.depthLinearMove, {"Z", "F", "S"}),
+	depthFastMove(gcode.depthFastMove, {"Z"}),
+	cwArcMove(gcode.cwArcMove, {"X", "Y", "I", "J", "F", "S"}),
+	ccwArcMove(gcode.ccwArcMove, {"X", "Y", "I", "J", "F", "S"})
+{
+}
+
+}
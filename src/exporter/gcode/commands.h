@@ -0,0 +1,28 @@
+#pragma once
+
+#include <exporter/gcode/commandtemplate.h>
+
+#include <config/config.h>
+
+namespace exporter::gcode
+{
+
+/** @brief Profile gcode commands compiled once per export.
+ * Each command only accepts the arguments provided when it is emitted.
+ */
+struct Commands
+{
+	CommandTemplate preCut;
+	CommandTemplate postCut;
+	CommandTemplate planeLinearMove;
+	CommandTemplate planeFastMove;
+	CommandTemplate depthLinearMove;
+	CommandTemplate depthFastMove;
+	CommandTemplate cwArcMove;
+	CommandTemplate ccwArcMove;
+
+	/// @throw common::GCodeFormatException if any command format is invalid
+	explicit Commands(const config::Profiles::Profile::Gcode::Snapshot &gcode);
+};
+
+}
@@ -0,0 +1,200 @@
+#include <commandtemplate.h>
+
+#include <common/exception.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace exporter::gcode
+{
+
+namespace
+{
+
+constexpr int MaxFixedPrecision = 9;
+
+constexpr std::array<uint64_t, MaxFixedPrecision + 1> powersOfTen = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+struct ArgumentName
+{
+	std::string_view name;
+	float CommandArguments::*argument;
+};
+
+constexpr std::array<ArgumentName, 7> argumentNames = {{
+	{"X", &CommandArguments::X},
+	{"Y", &CommandArguments::Y},
+	{"Z", &CommandArguments::Z},
+	{"I", &CommandArguments::I},
+	{"J", &CommandArguments::J},
+	{"F", &CommandArguments::F},
+	{"S", &CommandArguments::S}
+}};
+
+std::string joinNames(std::initializer_list<std::string_view> names)
+{
+	std::string joined;
+	for (const std::string_view &name : names) {
+		if (!joined.empty()) {
+			joined += ' ';
+		}
+		joined += name;
+	}
+
+	return joined;
+}
+
+/// Return number of decimals if spec is exactly ".Nf", -1 otherwise
+int parseFixedPrecision(std::string_view spec)
+{
+	if (spec.size() != 3 || spec[0] != '.' || spec[2] != 'f' || spec[1] < '0' || spec[1] > '9') {
+		return -1;
+	}
+
+	return spec[1] - '0';
+}
+
+void appendDecimal(std::string &output, uint64_t value, int minDigits)
+{
+	std::array<char, 20> digits;
+	int size = 0;
+	do {
+		digits[size++] = '0' + (value % 10);
+		value /= 10;
+	} while (value > 0);
+
+	for (; size < minDigits; ++size) {
+		digits[size] = '0';
+	}
+
+	while (size > 0) {
+		output += digits[--size];
+	}
+}
+
+}
+
+void writeFixedPrecision(std::string &output, float value, int precision)
+{
+	/* A float mantissa holds 24 bits, multiplied by 10^precision (at most 30 bits
+	 * for precision 9) it fits in the 53 bits of a double mantissa: the scaled value
+	 * is exact and rounding it half to even matches fmt output.
+	 */
+	const double scaled = std::abs((double)value * powersOfTen[precision]);
+	if (!std::isfinite(scaled) || scaled >= 1e18) {
+		output += fmt::format("{:.{}f}", value, precision);
+		return;
+	}
+
+	const uint64_t rounded = std::nearbyint(scaled);
+
+	if (std::signbit(value)) {
+		output += '-';
+	}
+
+	const uint64_t divisor = powersOfTen[precision];
+	appendDecimal(output, rounded / divisor, 1);
+	if (precision > 0) {
+		output += '.';
+		appendDecimal(output, rounded % divisor, precision);
+	}
+}
+
+void CommandTemplate::compile(const std::string &format, std::initializer_list<std::string_view> arguments)
+{
+	const auto throwError = [&format, &arguments](const char *error) {
+		throw common::GCodeFormatException(format, error, joinNames(arguments));
+	};
+
+	std::string literal;
+	const size_t size = format.size();
+
+	for (size_t i = 0; i < size; ++i) {
+		const char c = format[i];
+		if (c == '}') {
+			if (i + 1 < size && format[i + 1] == '}') {
+				literal += '}';
+				++i;
+				continue;
+			}
+			throwError("unmatched '}' in format string");
+		}
+
+		if (c != '{') {
+			literal += c;
+			continue;
+		}
+
+		if (i + 1 < size && format[i + 1] == '{') {
+			literal += '{';
+			++i;
+			continue;
+		}
+
+		const size_t end = format.find('}', i + 1);
+		if (end == std::string::npos) {
+			throwError("invalid format string");
+		}
+
+		const std::string_view field = std::string_view(format).substr(i + 1, end - i - 1);
+		const size_t colon = field.find(':');
+		const std::string_view name = field.substr(0, colon);
+		const std::string_view spec = (colon == std::string_view::npos) ? std::string_view() : field.substr(colon + 1);
+
+		// Only arguments provided by the command are accepted
+		const auto isName = [&name](const std::string_view &argument){ return argument == name; };
+		const auto argumentIt = std::find_if(argumentNames.begin(), argumentNames.end(),
+			[&name](const ArgumentName &argument){ return argument.name == name; });
+		if (argumentIt == argumentNames.end() || std::none_of(arguments.begin(), arguments.end(), isName)) {
+			throwError("argument not found");
+		}
+
+		Slot slot{std::move(literal), argumentIt->argument, parseFixedPrecision(spec), ""};
+		if (slot.precision < 0) {
+			slot.format = "{:" + std::string(spec) + "}";
+			// Validate specification now rather than during export
+			try {
+				static_cast<void>(fmt::format(slot.format, 0.0f));
+			}
+			catch (const fmt::format_error &exception) {
+				throwError(exception.what());
+			}
+		}
+
+		m_slots.push_back(std::move(slot));
+		literal.clear();
+		i = end;
+	}
+
+	m_tail = std::move(literal);
+}
+
+CommandTemplate::CommandTemplate(const std::string &format, std::initializer_list<std::string_view> arguments)
+{
+	compile(format, arguments);
+}
+
+void CommandTemplate::render(std::string &output, const CommandArguments &arguments) const
+{
+	for (const Slot &slot : m_slots) {
+		output += slot.literal;
+
+		const float value = arguments.*slot.argument;
+		if (slot.precision >= 0) {
+			writeFixedPrecision(output, value, slot.precision);
+		}
+		else {
+			output += fmt::format(slot.format, value);
+		}
+	}
+
+	output += m_tail;
+}
+
+}
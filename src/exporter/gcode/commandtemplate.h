@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <initializer_list>
+
+namespace exporter::gcode
+{
+
+/** @brief Values of the named arguments available to gcode commands.
+ */
+struct CommandArguments
+{
+	float X = 0.0f;
+	float Y = 0.0f;
+	float Z = 0.0f;
+	float I = 0.0f;
+	float J = 0.0f;
+	float F = 0.0f;
+	float S = 0.0f;
+};
+
+/** @brief Gcode command format parsed once into literal chunks and argument slots.
+ * The format follows fmt syntax with named arguments, e.g "G1 X {X:.3f} F {F:.3f}".
+ * Fixed precision float specifications (".Nf") are rendered by a dedicated writer
+ * producing the same output as fmt, any other specification is forwarded to fmt.
+ */
+class CommandTemplate
+{
+private:
+	struct Slot
+	{
+		/// Text preceding the argument
+		std::string literal;
+		float CommandArguments::*argument;
+		/// Number of decimals for fixed precision writer, negative when using fmt
+		int precision;
+		/// Single argument fmt format when not using fixed precision writer
+		std::string format;
+	};
+
+	std::vector<Slot> m_slots;
+	/// Text following the last argument
+	std::string m_tail;
+
+	void compile(const std::string &format, std::initializer_list<std::string_view> arguments);
+
+public:
+	/** Compile a format
+	 * @param format A fmt valid format string.
+	 * @param arguments Names of the arguments usable in format.
+	 * @throw common::GCodeFormatException if format is invalid or uses an unknown argument.
+	 */
+	explicit CommandTemplate(const std::string &format, std::initializer_list<std::string_view> arguments);
+	CommandTemplate() = default;
+
+	/// Append formatted command to output
+	void render(std::string &output, const CommandArguments &arguments) const;
+};
+
+/// Append value as decimal with a fixed number of decimals, same as fmt "{:.Nf}"
+void writeFixedPrecision(std::string &output, float value, int precision);
+
+}
@@ -1,33 +1,110 @@
 #include <exporter.h>
 #include <pathpostprocessor.h>
 
+#include <common/parallel.h>
+
+#include <sstream>
+#include <cmath>
+
 namespace exporter::gcode
 {
 
+/** Arc center relative to arc start. Rounding noise of the center computed from bulge tangent
+ * is removed to export axis aligned centers as exact zero.
+ */
+static geometry::Vector2D relativeArcCenter(const geometry::Arc &arc)
+{
+	const double precision = arc.radius() * 1e-9;
+	const auto denoise = [precision](double value){
+		return (std::abs(value) < precision) ? 0.0 : value;
+	};
+
+	const geometry::Vector2D relativeCenter = arc.center() - arc.start();
+	return geometry::Vector2D(denoise(relativeCenter.x()), denoise(relativeCenter.y()));
+}
+
+model::Passes Exporter::passes(const model::Path &path) const
+{
+	return model::Passes(path, m_profile.cut.direction, m_tool.general.depthPerCut);
+}
+
+geometry::Vector2D Exporter::optimizeStartPoints(const model::Path &path, geometry::Polyline::List &polylines, geometry::Vector2D toolPosition) const
+{
+	const model::Passes passes = this->passes(path);
+
+	for (geometry::Polyline &polyline : polylines) {
+		if (polyline.isClosed()) {
+			polyline.rotateToClosestStart(toolPosition);
+		}
+
+		toolPosition = passes.exit(polyline);
+	}
+
+	return toolPosition;
+}
+
 void Exporter::convertToGCode(const model::Task &task, std::ostream &output) const
 {
-	PostProcessor processor(m_tool, m_profile.gcode(), output);
+	PostProcessor processor(m_tool, m_commands, output);
 
 	// Retract tool before work piece
 	processor.retractDepth();
 
-	task.forEachPathInStack([this, &output](const model::Path &path){
+	model::Path::ListCPtr paths;
+	task.forEachPathInStack([&paths](const model::Path &path){
 		if (path.globallyVisible()) {
-			convertToGCode(path, output);
+			paths.push_back(&path);
 		}
 	});
 
+	const bool optimizeStartPoint = m_profile.cut.optimizeStartPoint;
+	// Tool starts at home
+	geometry::Vector2D toolPosition(0.0f, 0.0f);
+
+	/* Paths are formatted concurrently by chunks into their own buffer,
+	 * buffers are then written in stack order to keep output identical.
+	 */
+	std::vector<geometry::Polyline::List> polylines;
+	std::vector<std::string> buffers;
+	for (size_t chunkBegin = 0; chunkBegin < paths.size(); chunkBegin += PathsPerChunk) {
+		const size_t chunkSize = std::min(PathsPerChunk, paths.size() - chunkBegin);
+		polylines.resize(chunkSize);
+		buffers.resize(chunkSize);
+
+		if (optimizeStartPoint) {
+			// Start of a path depends on the end of the previous one, resolve them sequentially.
+			for (size_t index = 0; index < chunkSize; ++index) {
+				const model::Path &path = *paths[chunkBegin + index];
+				polylines[index] = path.finalPolylines();
+				toolPosition = optimizeStartPoints(path, polylines[index], toolPosition);
+			}
+		}
+
+		common::parallelFor(chunkSize, [this, &paths, &polylines, &buffers, chunkBegin, optimizeStartPoint](size_t index){
+			const model::Path &path = *paths[chunkBegin + index];
+			if (!optimizeStartPoint) {
+				polylines[index] = path.finalPolylines();
+			}
+
+			std::ostringstream stream;
+			convertToGCode(path, polylines[index], stream);
+			buffers[index] = stream.str();
+		});
+
+		for (const std::string &buffer : buffers) {
+			output << buffer;
+		}
+	}
+
 	// Back to home
-	processor.fastPlaneMove(QVector2D(0.0f, 0.0f));
+	processor.fastPlaneMove(geometry::Vector2D(0.0f, 0.0f));
 }
 
-void Exporter::convertToGCode(const model::Path &path, std::ostream &output) const
+void Exporter::convertToGCode(const model::Path &path, const geometry::Polyline::List &polylines, std::ostream &output) const
 {
 	const model::PathSettings &settings = path.settings();
-	const geometry::CuttingDirection cuttingDirection = path.cuttingDirection() | m_profile.cut().direction();
-	PathPostProcessor processor(settings, m_tool, m_profile.gcode(), output);
-
-	const geometry::Polyline::List polylines = path.finalPolylines();
+	const geometry::CuttingDirection cuttingDirection = passes(path).direction();
+	PathPostProcessor processor(settings, m_tool, m_commands, output);
 
 	// Depth to be cut
 	const float depth = settings.depth();
@@ -89,7 +166,7 @@ public:
 
 void Exporter::convertToGCode(PathPostProcessor &processor, const geometry::Polyline &polyline, float maxDepth, geometry::CuttingDirection cuttingDirection) const
 {
-	const float depthPerCut = m_tool.general().depthPerCut();
+	const float depthPerCut = m_tool.general.depthPerCut;
 
 	PassesIterator iterator(polyline, cuttingDirection);
 
@@ -111,19 +188,21 @@ void Exporter::convertToGCode(PathPostProcessor &processor, const geometry::Poly
 
 void Exporter::convertToGCode(PathPostProcessor &processor, const geometry::Polyline &polyline) const
 {
-	polyline.forEachBulge([this, &processor](const geometry::Bulge &bulge){ convertToGCode(processor, bulge); });
+	// Arcs are computed once for all depth passes
+	polyline.forEachBulgeWithArc([this, &processor](const geometry::Bulge &bulge, const std::optional<geometry::Arc> &arc){
+		convertToGCode(processor, bulge, arc);
+	});
 }
 
-void Exporter::convertToGCode(PathPostProcessor &processor, const geometry::Bulge &bulge) const
+void Exporter::convertToGCode(PathPostProcessor &processor, const geometry::Bulge &bulge, const std::optional<geometry::Arc> &arc) const
 {
-	if (bulge.isLine()) {
+	if (!arc) {
 		processor.planeLinearMove(bulge.end());
 	}
 	else {
-		const geometry::Circle circle = bulge.toCircle();
 		// Relative center to start
-		const QVector2D relativeCenter = circle.center() - bulge.start();
-		switch (circle.orientation()) {
+		const geometry::Vector2D relativeCenter = relativeArcCenter(*arc);
+		switch (arc->orientation()) {
 			case geometry::Orientation::CW:
 				processor.cwArcMove(relativeCenter, bulge.end());
 				break;
@@ -192,19 +271,28 @@ void convertConfigNodeToComments(const Group &group, std::ostream &output)
 	visitor(group);
 }
 
+std::string Exporter::configComments(const config::Tools::Tool& tool, const config::Profiles::Profile& profile, Options options)
+{
+	std::ostringstream output;
+	if (options & ExportConfig) {
+		convertConfigNodeToComments(tool, output);
+		convertConfigNodeToComments(profile, output);
+	}
+
+	return output.str();
+}
+
 Exporter::Exporter(const config::Tools::Tool& tool, const config::Profiles::Profile& profile, Options options)
-	:m_tool(tool),
-	m_profile(profile),
-	m_options(options)
+	:m_tool(tool.snapshot()),
+	m_profile(profile.snapshot()),
+	m_commands(m_profile.gcode),
+	m_configComments(configComments(tool, profile, options))
 {
 }
 
 void Exporter::operator()(const model::Document &document, std::ostream &output) const
 {
-	if (m_options & ExportConfig) {
-		convertConfigNodeToComments(m_tool, output);
-		convertConfigNodeToComments(m_profile, output);
-	}
+	output << m_configComments;
 
 	convertToGCode(document.task(), output);
 }
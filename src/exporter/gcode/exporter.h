@@ -1,6 +1,9 @@
 #pragma once
 
 #include <model/document.h>
+#include <model/passes.h>
+
+#include <exporter/gcode/commands.h>
 
 #include <config/config.h>
 
@@ -21,20 +24,36 @@ public:
 	};
 
 private:
-	const config::Tools::Tool &m_tool;
-	const config::Profiles::Profile &m_profile;
-	const Options m_options;
+	/// Number of paths formatted concurrently before being written to output
+	static constexpr size_t PathsPerChunk = 1024;
+
+	/// Configuration values captured once for the whole export
+	const config::Tools::Tool::Snapshot m_tool;
+	const config::Profiles::Profile::Snapshot m_profile;
+	const Commands m_commands;
+	/// Configuration rendered as gcode comments, empty without ExportConfig option
+	const std::string m_configComments;
+
+	static std::string configComments(const config::Tools::Tool& tool, const config::Profiles::Profile& profile, Options options);
+
+	model::Passes passes(const model::Path &path) const;
+	/** Rotate closed polylines of a path to start nearest to tool position
+	 * @return Tool position after cutting the polylines
+	 */
+	geometry::Vector2D optimizeStartPoints(const model::Path &path, geometry::Polyline::List &polylines, geometry::Vector2D toolPosition) const;
 
 	void convertToGCode(const model::Task &task, std::ostream &output) const;
-	void convertToGCode(const model::Path &path, std::ostream &output) const;
+	void convertToGCode(const model::Path &path, const geometry::Polyline::List &polylines, std::ostream &output) const;
 	void convertToGCode(PathPostProcessor &processor, const geometry::Polyline &polyline) const;
 	void convertToGCode(PathPostProcessor &processor, const geometry::Polyline &polyline, float maxDepth, geometry::CuttingDirection cuttingDirection) const;
-	void convertToGCode(PathPostProcessor &processor, const geometry::Bulge &bulge) const;
+	void convertToGCode(PathPostProcessor &processor, const geometry::Bulge &bulge, const std::optional<geometry::Arc> &arc) const;
 
 public:
+	/// @throw common::GCodeFormatException if a profile gcode format is invalid
 	explicit Exporter(const config::Tools::Tool& tool, const config::Profiles::Profile& profile, Options options = None);
 	~Exporter() = default;
 
+	/// Safe to call concurrently, configuration is not accessed after construction.
 	void operator()(const model::Document& document, std::ostream &output)  const;
 };
 
@@ -1,41 +1,67 @@
 #include <pathpostprocessor.h>
 
-using namespace fmt::literals;
-
 namespace exporter::gcode
 {
 
-PathPostProcessor::PathPostProcessor(const model::PathSettings &settings, const config::Tools::Tool& tool, const config::Profiles::Profile::Gcode& gcode, std::ostream &stream)
-	:PostProcessor(tool, gcode, stream),
+void PathPostProcessor::printWithSettings(const CommandTemplate &command, CommandArguments arguments)
+{
+	arguments.S = m_settings.intensity();
+
+	print(command, arguments);
+}
+
+PathPostProcessor::PathPostProcessor(const model::PathSettings &settings, const config::Tools::Tool::Snapshot& tool, const Commands& commands, std::ostream &stream)
+	:PostProcessor(tool, commands, stream),
 	m_settings(settings)
 {
 }
 
 void PathPostProcessor::preCut()
 {
-	printWithSettings(m_gcode.preCut());
+	printWithSettings(m_commands.preCut);
 }
 
-void PathPostProcessor::planeLinearMove(const QVector2D &to)
+void PathPostProcessor::planeLinearMove(const geometry::Vector2D &to)
 {
-	printWithSettings(m_gcode.planeLinearMove(), "X"_a=to.x(), "Y"_a=to.y(), "F"_a=m_settings.planeFeedRate());
+	CommandArguments arguments;
+	arguments.X = to.x();
+	arguments.Y = to.y();
+	arguments.F = m_settings.planeFeedRate();
+
+	printWithSettings(m_commands.planeLinearMove, arguments);
 }
 
 void PathPostProcessor::depthLinearMove(float depth)
 {
-	printWithSettings(m_gcode.depthLinearMove(), "Z"_a=depth, "F"_a=m_settings.depthFeedRate());
+	CommandArguments arguments;
+	arguments.Z = depth;
+	arguments.F = m_settings.depthFeedRate();
+
+	printWithSettings(m_commands.depthLinearMove, arguments);
 }
 
-void PathPostProcessor::cwArcMove(const QVector2D &relativeCenter, const QVector2D &to)
+void PathPostProcessor::cwArcMove(const geometry::Vector2D &relativeCenter, const geometry::Vector2D &to)
 {
-	printWithSettings(m_gcode.cwArcMove(), "X"_a=to.x(), "Y"_a=to.y(),
-		"I"_a=relativeCenter.x(), "J"_a=relativeCenter.y(), "F"_a=m_settings.planeFeedRate());
+	CommandArguments arguments;
+	arguments.X = to.x();
+	arguments.Y = to.y();
+	arguments.I = relativeCenter.x();
+	arguments.J = relativeCenter.y();
+	arguments.F = m_settings.planeFeedRate();
+
+	printWithSettings(m_commands.cwArcMove, arguments);
 }
 
-void PathPostProcessor::ccwArcMove(const QVector2D &relativeCenter, const QVector2D &to)
+void PathPostProcessor::ccwArcMove(const geometry::Vector2D &relativeCenter, const geometry::Vector2D &to)
 {
-	printWithSettings(m_gcode.ccwArcMove(), "X"_a=to.x(), "Y"_a=to.y(),
-		"I"_a=relativeCenter.x(), "J"_a=relativeCenter.y(), "F"_a=m_settings.planeFeedRate());
+	CommandArguments arguments;
+	arguments.X = to.x();
+	arguments.Y = to.y();
+	arguments.I = relativeCenter.x();
+	arguments.J = relativeCenter.y();
+	arguments.F = m_settings.planeFeedRate();
+
+	printWithSettings(m_commands.ccwArcMove, arguments);
 }
 
 }
@@ -2,8 +2,6 @@
 
 #include <exporter/gcode/postprocessor.h>
 
-using namespace fmt::literals;
-
 namespace exporter::gcode
 {
 
@@ -14,22 +12,16 @@ class PathPostProcessor : public PostProcessor
 private:
 	const model::PathSettings &m_settings;
 
-	template <class ...Args>
-	void printWithSettings(const std::string &format, Args&& ...args)
-	{
-		print(format, std::forward<Args>(args)...,
-			  "S"_a=m_settings.intensity());
-	}
+	void printWithSettings(const CommandTemplate &command, CommandArguments arguments = CommandArguments());
 
 public:
-	explicit PathPostProcessor(const model::PathSettings &settings, const config::Tools::Tool& tool, const config::Profiles::Profile::Gcode& gcode, std::ostream &stream);
+	explicit PathPostProcessor(const model::PathSettings &settings, const config::Tools::Tool::Snapshot& tool, const Commands& commands, std::ostream &stream);
 
 	void preCut();
-	void planeLinearMove(const QVector2D &to);
+	void planeLinearMove(const geometry::Vector2D &to);
 	void depthLinearMove(float depth);
-	void cwArcMove(const QVector2D &relativeCenter, const QVector2D &to);
-	void ccwArcMove(const QVector2D &relativeCenter, const QVector2D &to);
+	void cwArcMove(const geometry::Vector2D &relativeCenter, const geometry::Vector2D &to);
+	void ccwArcMove(const geometry::Vector2D &relativeCenter, const geometry::Vector2D &to);
 };
 
 }
-
@@ -1,30 +1,44 @@
 #include <postprocessor.h>
 
-using namespace fmt::literals;
-
 namespace exporter::gcode
 {
 
-PostProcessor::PostProcessor(const config::Tools::Tool& tool, const config::Profiles::Profile::Gcode& gcode, std::ostream &stream)
+void PostProcessor::print(const CommandTemplate &command, const CommandArguments &arguments)
+{
+	m_line.clear();
+	command.render(m_line, arguments);
+	m_line += '\n';
+
+	m_stream << m_line;
+}
+
+PostProcessor::PostProcessor(const config::Tools::Tool::Snapshot& tool, const Commands& commands, std::ostream &stream)
 	:m_stream(stream),
 	m_tool(tool),
-	m_gcode(gcode)
+	m_commands(commands)
 {
 }
 
 void PostProcessor::postCut()
 {
-	print(m_gcode.postCut());
+	print(m_commands.postCut);
 }
 
-void PostProcessor::fastPlaneMove(const QVector2D &to)
+void PostProcessor::fastPlaneMove(const geometry::Vector2D &to)
 {
-	print(m_gcode.planeFastMove(), "X"_a=to.x(), "Y"_a=to.y());
+	CommandArguments arguments;
+	arguments.X = to.x();
+	arguments.Y = to.y();
+
+	print(m_commands.planeFastMove, arguments);
 }
 
 void PostProcessor::retractDepth()
 {
-	print(m_gcode.depthFastMove(), "Z"_a=m_tool.general().retractDepth());
+	CommandArguments arguments;
+	arguments.Z = m_tool.general.retractDepth;
+
+	print(m_commands.depthFastMove, arguments);
 }
 
 }
@@ -1,11 +1,9 @@
 #pragma once
 
 #include <model/path.h>
-#include <exporter/gcode/exporter.h>
-#include <common/exception.h>
+#include <exporter/gcode/commands.h>
 
-#include <fmt/format.h>
-#include <sstream>
+#include <ostream>
 
 namespace exporter::gcode
 {
@@ -14,33 +12,25 @@ class PostProcessor
 {
 private:
 	std::ostream &m_stream;
+	/// Line buffer reused for every command
+	std::string m_line;
 
 protected:
-	const config::Tools::Tool& m_tool;
-	const config::Profiles::Profile::Gcode& m_gcode;
+	const config::Tools::Tool::Snapshot& m_tool;
+	const Commands& m_commands;
 
-	/** Print a command to stream with a format and a list of named arguments
-	 * @param format A fmt valid format string.
-	 * @param args List of named arguments
+	/** Print a command to stream
+	 * @param command A compiled command template.
+	 * @param arguments Values of the named arguments
 	 */
-	template <class ...Args>
-	void print(const std::string &format, Args&& ...args)
-	{
-		try {
-			m_stream << fmt::format(format, std::forward<Args>(args)...) << "\n";
-		}
-		catch (const fmt::format_error &exception) {
-			throw common::GCodeFormatException(format, exception.what(), fmt::to_string(args.name)...);
-		}
-	}
+	void print(const CommandTemplate &command, const CommandArguments &arguments = CommandArguments());
 
 public:
-	explicit PostProcessor(const config::Tools::Tool& tool, const config::Profiles::Profile::Gcode& gcode, std::ostream &stream);
+	explicit PostProcessor(const config::Tools::Tool::Snapshot& tool, const Commands& commands, std::ostream &stream);
 
 	void postCut();
-	void fastPlaneMove(const QVector2D &to);
+	void fastPlaneMove(const geometry::Vector2D &to);
 	void retractDepth();
 };
 
 }
-
@@ -20,9 +20,9 @@ Assembler::ChainBuilder::ChainBuilder(const Tip::List &tips, std::set<PolylineIn
 /// Average point at p1 end and p2 start and assign middle point to both
 static void averageStartEndPolyline(Polyline &first, Polyline &second)
 {
-	const QVector2D middlePoint = (first.end() + second.start()) / 2.0f;
-	first.end() = middlePoint;
-	second.start() = middlePoint;
+	const Vector2D middlePoint = (first.end() + second.start()) / 2.0f;
+	first.setEnd(middlePoint);
+	second.setStart(middlePoint);
 }
 
 Polyline Assembler::ChainBuilder::mergedPolyline(const Polyline::List& polylines) const
@@ -62,7 +62,7 @@ size_t Assembler::TipAdaptor::kdtree_get_point_count() const
 	return m_tips.size();
 }
 
-float Assembler::TipAdaptor::kdtree_get_pt(const size_t idx, const size_t dim) const
+double Assembler::TipAdaptor::kdtree_get_pt(const size_t idx, const size_t dim) const
 {
 	return m_tips[idx].point[dim];
 }
@@ -4,6 +4,7 @@
 
 #include <nanoflann.hpp>
 
+#include <list>
 #include <set>
 
 namespace geometry
@@ -19,7 +20,7 @@ private:
 	{
 		PolylineIndex polylineIndex;
 		// Original point from polyline.
-		QVector2D point;
+		Vector2D point;
 
 		enum class Type {
 			START = 0,
@@ -41,7 +42,7 @@ private:
 		explicit TipAdaptor(const Tip::List &tips);
 
 		size_t kdtree_get_point_count() const;
-		float kdtree_get_pt(const size_t idx, const size_t dim) const;
+		double kdtree_get_pt(const size_t idx, const size_t dim) const;
 
 		template <class BBOX>
 		bool kdtree_get_bbox([[maybe_unused]] BBOX &bb) const
@@ -50,7 +51,7 @@ private:
 		}
 	};
 
-	using KDTree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<float, TipAdaptor>, TipAdaptor, 2>;
+	using KDTree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<double, TipAdaptor>, TipAdaptor, 2>;
 
 	class ChainBuilder
 	{
@@ -88,11 +89,11 @@ private:
 				const Tip &tip = m_tips[tipIndex];
 
 				// Coordinate of search point.
-				const float coord[2] = {tip.point.x(), tip.point.y()};
+				const double coord[2] = {tip.point.x(), tip.point.y()};
 
 				// Nearest neighbour with distance.
 				std::array<size_t, 2> matchIndices;
-				std::array<float, 2> matchDistances;
+				std::array<double, 2> matchDistances;
 
 				// Search for the nearest neighbours.
 				const int nbMatches = m_tree.knnSearch(coord, 2, matchIndices.data(), matchDistances.data());
@@ -11,9 +11,9 @@ bool Bezier::isRealInflexionPoint(const Bezier::Complex &point)
 
 Bezier::InflexionPoints Bezier::inflexions() const
 {
-	const QVector2D A = m_control1 - m_point1;
-	const QVector2D B = m_control2 - m_control1 - A;
-	const QVector2D C = m_point2 - m_control2 - A - 2.0f * B;
+	const Vector2D A = m_control1 - m_point1;
+	const Vector2D B = m_control2 - m_control1 - A;
+	const Vector2D C = m_point2 - m_control2 - A - 2.0f * B;
     
 	const Complex a(B.x() * C.y() - B.y() * C.x(), 0.0f);
 	const Complex b(A.x() * C.y() - A.y() * C.x(), 0.0f);
@@ -40,7 +40,7 @@ Bezier::InflexionPoints Bezier::inflexions() const
 	return {t1, t2};
 }
 
-QVector2D Bezier::derivativeAt(float t) const
+Vector2D Bezier::derivativeAt(float t) const
 {
 	const float s = 1.0 - t;
 	const float s2 = s * s;
@@ -50,17 +50,17 @@ QVector2D Bezier::derivativeAt(float t) const
 			3.0f * m_control2 * (2.0f * t * s - t2) + 3.0f * m_point2 * t2);
 }
 
-QVector2D Bezier::findNearestPointWithTangent(const QVector2D &point, const QVector2D& tangent, float maxError) const
+Vector2D Bezier::findNearestPointWithTangent(const Vector2D &point, const Vector2D& tangent, float maxError) const
 {
 	float tn = 0.5f;
-	QVector2D Q_tn = at(tn);
+	Vector2D Q_tn = at(tn);
 
-	const float dpt = QVector2D::dotProduct(point, tangent);
-	float fn = QVector2D::dotProduct(Q_tn, tangent) - dpt;
+	const float dpt = Vector2D::dotProduct(point, tangent);
+	float fn = Vector2D::dotProduct(Q_tn, tangent) - dpt;
 
 	while (std::abs(fn) > maxError) {
-		const QVector2D d_Q_tn = derivativeAt(tn);
-		const float d_fn = QVector2D::dotProduct(d_Q_tn, tangent);
+		const Vector2D d_Q_tn = derivativeAt(tn);
+		const float d_fn = Vector2D::dotProduct(d_Q_tn, tangent);
 
 		tn = tn - fn / d_fn;
 
@@ -70,13 +70,13 @@ QVector2D Bezier::findNearestPointWithTangent(const QVector2D &point, const QVec
 		}
 
 		Q_tn = at(tn);
-		fn = QVector2D::dotProduct(Q_tn, tangent) - dpt;
+		fn = Vector2D::dotProduct(Q_tn, tangent) - dpt;
 	}
 
 	return Q_tn;
 }
 
-Bezier::Bezier(const QVector2D &p1, const QVector2D &c1, const QVector2D &c2, const QVector2D &p2)
+Bezier::Bezier(const Vector2D &p1, const Vector2D &c1, const Vector2D &c2, const Vector2D &p2)
 	:m_point1(p1),
 	m_point2(p2),
 	m_control1(c1),
@@ -84,27 +84,27 @@ Bezier::Bezier(const QVector2D &p1, const QVector2D &c1, const QVector2D &c2, co
 {
 }
 
-const QVector2D &Bezier::point1() const
+const Vector2D &Bezier::point1() const
 {
 	return m_point1;
 }
 
-const QVector2D &Bezier::point2() const
+const Vector2D &Bezier::point2() const
 {
 	return m_point2;
 }
 
-const QVector2D &Bezier::control1() const
+const Vector2D &Bezier::control1() const
 {
 	return m_control1;
 }
 
-const QVector2D &Bezier::control2() const
+const Vector2D &Bezier::control2() const
 {
 	return m_control2;
 }
 
-QVector2D Bezier::at(float t) const
+Vector2D Bezier::at(float t) const
 {
 	assert(0.0f <= t && t <= 1.0f);
 
@@ -130,14 +130,14 @@ Bezier::Pair Bezier::split(float t) const
 {
 	assert(0.0f < t && t < 1.0f);
 
-	const QVector2D p0 = m_point1 + t * (m_control1 - m_point1);
-	const QVector2D p1 = m_control1 + t * (m_control2 - m_control1);
-	const QVector2D p2 = m_control2 + t * (m_point2 - m_control2);
+	const Vector2D p0 = m_point1 + t * (m_control1 - m_point1);
+	const Vector2D p1 = m_control1 + t * (m_control2 - m_control1);
+	const Vector2D p2 = m_control2 + t * (m_point2 - m_control2);
 
-	const QVector2D p01 = p0 + t * (p1 - p0);
-	const QVector2D p12 = p1 + t * (p2 - p1);
+	const Vector2D p01 = p0 + t * (p1 - p0);
+	const Vector2D p12 = p1 + t * (p2 - p1);
 
-	const QVector2D dp = p01 + t * (p12 - p01);
+	const Vector2D dp = p01 + t * (p12 - p01);
 
 	const Bezier b1(m_point1, p0, p01, dp);
 	const Bezier b2(dp, p12, p2, m_point2);
@@ -147,14 +147,14 @@ Bezier::Pair Bezier::split(float t) const
 
 Bezier::Pair Bezier::splitHalf() const
 {
-	const QVector2D qc = (m_control1 + m_control2) / 4.0f;
+	const Vector2D qc = (m_control1 + m_control2) / 4.0f;
 
-	const QVector2D r2 = (m_point1 + m_control1) / 2.0f;
-	const QVector2D r3 = r2 / 2.0f + qc;
+	const Vector2D r2 = (m_point1 + m_control1) / 2.0f;
+	const Vector2D r3 = r2 / 2.0f + qc;
 
-	const QVector2D s3 = (m_control2 + m_point2) / 2.0f;
-	const QVector2D s2 = s3 / 2.0f + qc;
-	const QVector2D dp = (r3 + s2) / 2.0f;
+	const Vector2D s3 = (m_control2 + m_point2) / 2.0f;
+	const Vector2D s2 = s3 / 2.0f + qc;
+	const Vector2D dp = (r3 + s2) / 2.0f;
 
 	const Bezier b1(m_point1, r2, r3, dp);
 	const Bezier b2(dp, s2, s3, m_point2);
@@ -214,7 +214,7 @@ Bezier::List Bezier::splitToConvex() const
 std::optional<Biarc> Bezier::toBiarc() const
 {
 	// First find V, second vertex of triangle.
-	const std::optional<QVector2D> optIntersection = ForwardLineIntersection(m_point1, m_control1, m_point2, m_control2);
+	const std::optional<Vector2D> optIntersection = ForwardLineIntersection(m_point1, m_control1, m_point2, m_control2);
 
 	/* If the intersection is not forward (from direction P1 -> C1) or the tangents are parrallels,
 	 * no biars can be computed.
@@ -223,10 +223,10 @@ std::optional<Biarc> Bezier::toBiarc() const
 		return std::nullopt;
 	}
 
-	const QVector2D v = *optIntersection;
+	const Vector2D v = *optIntersection;
 
 	// Find (G) incenter of triangle P1 V P2
-	const QVector2D incenter = TriangleIncenter(m_point1, v, m_point2);
+	const Vector2D incenter = TriangleIncenter(m_point1, v, m_point2);
 
 	// Create biarc passing by P1 G P2 and with tangent at P1 and P2
 	Biarc biarc(m_point1, incenter, m_point2, (m_control1 - m_point1), (m_control2 - m_point2));
@@ -241,11 +241,11 @@ Polyline Bezier::toLine() const
 
 float Bezier::maxError(const Biarc &biarc) const
 {
-	const QVector2D &middle = biarc.middle();
-	const QVector2D tangent = biarc.tangentAtMiddle();
+	const Vector2D &middle = biarc.middle();
+	const Vector2D tangent = biarc.tangentAtMiddle();
 
 	// Find nearest point on curve to biarc middle with same tangent.
-	const QVector2D nearest = findNearestPointWithTangent(middle, tangent, 0.001); // TODO const
+	const Vector2D nearest = findNearestPointWithTangent(middle, tangent, 0.001); // TODO const
 
 	return (middle - nearest).lengthSquared();
 }
@@ -2,7 +2,7 @@
 
 #include <common/aggregable.h>
 
-#include <QVector2D>
+#include <geometry/vector2d.h>
 
 #include <complex>
 
@@ -17,29 +17,29 @@ private:
 	using Complex = std::complex<float>;
 	using InflexionPoints = std::array<Complex, 2>;
 
-	QVector2D m_point1;
-	QVector2D m_point2;
-	QVector2D m_control1;
-	QVector2D m_control2;
+	Vector2D m_point1;
+	Vector2D m_point2;
+	Vector2D m_control1;
+	Vector2D m_control2;
 
 	static bool isRealInflexionPoint(const Bezier::Complex &point);
 
 	InflexionPoints inflexions() const;
-	QVector2D derivativeAt(float t) const;
+	Vector2D derivativeAt(float t) const;
 
-	QVector2D findNearestPointWithTangent(const QVector2D &point, const QVector2D& tangent, float maxError) const;
+	Vector2D findNearestPointWithTangent(const Vector2D &point, const Vector2D& tangent, float maxError) const;
 
 public:
-	explicit Bezier(const QVector2D &p1, const QVector2D &c1,
-			const QVector2D &c2, const QVector2D &p2);
+	explicit Bezier(const Vector2D &p1, const Vector2D &c1,
+			const Vector2D &c2, const Vector2D &p2);
 	Bezier() = default;
 
-	const QVector2D &point1() const;
-	const QVector2D &point2() const;
-	const QVector2D &control1() const;
-	const QVector2D &control2() const;
+	const Vector2D &point1() const;
+	const Vector2D &point2() const;
+	const Vector2D &control1() const;
+	const Vector2D &control2() const;
 
-	QVector2D at(float t) const;
+	Vector2D at(float t) const;
 
 	float approximateLength() const;
 
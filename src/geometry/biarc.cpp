@@ -2,8 +2,6 @@
 #include <utils.h>
 #include <bulge.h>
 
-#include <QDebug>
-#include <QtMath>
 
 namespace geometry
 {
@@ -17,8 +15,8 @@ Orientation Biarc::orientation() const
 	return (det < 0.0f) ? Orientation::CW : Orientation::CCW;
 }
 
-Biarc::Biarc(const QVector2D& point1, const QVector2D& middle, const QVector2D& point2,
-		const QVector2D& tangent1, const QVector2D& tangent2)
+Biarc::Biarc(const Vector2D& point1, const Vector2D& middle, const Vector2D& point2,
+		const Vector2D& tangent1, const Vector2D& tangent2)
 	:m_point1(point1),
 	m_point2(point2),
 	m_middle(middle),
@@ -29,16 +27,16 @@ Biarc::Biarc(const QVector2D& point1, const QVector2D& middle, const QVector2D&
 {
 }
 
-const QVector2D &Biarc::middle() const
+const Vector2D &Biarc::middle() const
 {
 	return m_middle;
 }
 
-QVector2D Biarc::tangentAtMiddle() const
+Vector2D Biarc::tangentAtMiddle() const
 {
 	// Rotate line by PI/2
-	const QVector2D normalizedLine1 = m_line1.normalized();
-	const QVector2D perpendicularLine1 = PerpendicularLine(normalizedLine1);
+	const Vector2D normalizedLine1 = m_line1.normalized();
+	const Vector2D perpendicularLine1 = PerpendicularLine(normalizedLine1);
 
 	// Tangent at middle is the reflect of tangent at start by perpendicular line start to end.
 	return ReflectLine(m_tangent1.normalized(), perpendicularLine1);
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <QVector2D>
+#include <geometry/vector2d.h>
 
 #include <common/aggregable.h>
 
@@ -13,27 +13,27 @@ namespace geometry
 class Biarc : public common::Aggregable<Biarc>
 {
 private:
-	QVector2D m_point1;
-	QVector2D m_point2;
+	Vector2D m_point1;
+	Vector2D m_point2;
 	/// Intersection point of the arcs
-	QVector2D m_middle;
+	Vector2D m_middle;
 	/// Tangent at point1
-	QVector2D m_tangent1;
+	Vector2D m_tangent1;
 	/// Tangent at point1
-	QVector2D m_tangent2;
+	Vector2D m_tangent2;
 	/// Line from point1 to middle
-	QVector2D m_line1;
+	Vector2D m_line1;
 	/// Line from point2 to middle
-	QVector2D m_line2;
+	Vector2D m_line2;
 
 	Orientation orientation() const;
 
 public:
-	explicit Biarc(const QVector2D &point1, const QVector2D &middle, const QVector2D &point2,
-		const QVector2D &tangent1, const QVector2D &tangent2);
+	explicit Biarc(const Vector2D &point1, const Vector2D &middle, const Vector2D &point2,
+		const Vector2D &tangent1, const Vector2D &tangent2);
 
-	const QVector2D &middle() const;
-	QVector2D tangentAtMiddle() const;
+	const Vector2D &middle() const;
+	Vector2D tangentAtMiddle() const;
 
 	float approximateLength() const;
 
@@ -1,8 +1,8 @@
 #include <bulge.h>
 #include <utils.h>
+#include <algorithm>
 #include <limits>
 
-#include <QDebug> // TODO
 #include <iostream> // TODO
 #include <iomanip>
 #include <limits>
@@ -10,12 +10,12 @@
 namespace geometry
 {
 
-Bulge::Bulge(const QVector2D &start, const QVector2D &end, float tangent)
+Bulge::Bulge(const Vector2D &start, const Vector2D &end, double tangent)
 	:m_start(start),
 	m_end(end),
 	m_tangent(tangent)
 {
-	assert(-1.0f <= tangent && tangent <= 1.0f);
+	assert(-1.0 <= tangent && tangent <= 1.0);
 }
 
 Bulge::Bulge(const cavc::PlineVertex<double> &v1, const cavc::PlineVertex<double> &v2)
@@ -25,45 +25,45 @@ Bulge::Bulge(const cavc::PlineVertex<double> &v1, const cavc::PlineVertex<double
 {
 }
 
-const QVector2D &Bulge::start() const
+const Vector2D &Bulge::start() const
 {
 	return m_start;
 }
 
-QVector2D &Bulge::start()
+Vector2D &Bulge::start()
 {
 	return m_start;
 }
 
-const QVector2D &Bulge::end() const
+const Vector2D &Bulge::end() const
 {
 	return m_end;
 }
 
-QVector2D &Bulge::end()
+Vector2D &Bulge::end()
 {
 	return m_end;
 }
 
-float Bulge::tangent() const
+double Bulge::tangent() const
 {
 	return m_tangent;
 }
 
-float &Bulge::tangent()
+double &Bulge::tangent()
 {
 	return m_tangent;
 }
 
-float Bulge::length() const
+double Bulge::length() const
 {
 	if (isLine()) {
 		return m_start.distanceToPoint(m_end);
 	}
 
 	// Radius is half line length * 1 + t^2 / (4 * |t|)
-	const float radius = m_start.distanceToPoint(m_end) * (1.0f + m_tangent * m_tangent) / m_tangent;
-	const float angle = std::atan(m_tangent);
+	const double radius = m_start.distanceToPoint(m_end) * (1.0 + m_tangent * m_tangent) / m_tangent;
+	const double angle = std::atan(m_tangent);
 	return radius * angle;
 }
 
@@ -75,15 +75,15 @@ void Bulge::invert()
 
 void Bulge::linify()
 {
-	m_tangent = 0.0f;
+	m_tangent = 0.0;
 }
 
-Bulge Bulge::extendStart(const QVector2D &start) const
+Bulge Bulge::extendStart(const Vector2D &start) const
 {
 	return Bulge(start, m_end, m_tangent);
 }
 
-Bulge Bulge::extendEnd(const QVector2D &end) const
+Bulge Bulge::extendEnd(const Vector2D &end) const
 {
 	return Bulge(m_start, end, m_tangent);
 }
@@ -100,64 +100,243 @@ bool Bulge::isArc() const
 
 Orientation Bulge::orientation() const
 {
-	return (m_tangent < 0.0f) ? Orientation::CW : Orientation::CCW;
+	return (m_tangent < 0.0) ? Orientation::CW : Orientation::CCW;
 }
 
 Circle Bulge::toCircle() const
 {
-	const Orientation ori = orientation();
+	const Vector2D chord = m_end - m_start;
 
-	const float absTangent = std::abs(m_tangent);
+	// Center is on the chord bisector, on the left of the chord for counter clockwise arcs.
+	const double centerOffset = (1.0 - m_tangent * m_tangent) / (4.0 * m_tangent);
+	const Vector2D center = m_start + chord / 2.0 + centerOffset * PerpendicularLine(chord);
+	const double radius = chord.length() * (1.0 + m_tangent * m_tangent) / (4.0 * std::abs(m_tangent));
 
-	// Tangent is at end point, so we get line from end to start.
-	const QVector2D line = m_start - m_end;
+	return Circle(center, radius, orientation());
+}
 
-	const float lineLength = line.length();
-	const float radius = (lineLength * (1.0f + m_tangent * m_tangent)) / (4.0f * absTangent);
+Arc Bulge::toArc() const
+{
+	const Circle circle = toCircle();
+	const Vector2D &center = circle.center();
 
-	// Angle of line end -> start
-	const float lineAngle = LineAngle(line);
-	// Angle between line and line from end to middle of arc
-	const float absTheta4 = std::atan(absTangent);
+	const double startAngle = LineAngle(m_start - center);
+	const double endAngle = LineAngle(m_end - center);
 
-	// Absolute angle at end point from line to arc center.
-	const float relativeAngleToCenter = M_PI_2 - 2.0f * absTheta4;
-	const float angleToCenter = (ori == Orientation::CCW) ? (lineAngle - relativeAngleToCenter) : (lineAngle + relativeAngleToCenter);
+	return Arc(circle, m_start, m_end, startAngle, endAngle);
+}
+
+Vector2D Bulge::pointAt(double t) const
+{
+	if (isLine()) {
+		return m_start + t * (m_end - m_start);
+	}
 
-	const QVector2D relativeCenter(std::cos(angleToCenter) * radius, std::sin(angleToCenter) * radius);
-	const QVector2D center = relativeCenter + m_end;
+	const Circle circle = toCircle();
+	const Vector2D &center = circle.center();
+	// Signed angle of arc, positive when CCW.
+	const double angle = LineAngle(m_start - center) + t * 4.0 * std::atan(m_tangent);
 
-	return Circle(center, radius, ori);
+	return center + circle.radius() * Vector2D(std::cos(angle), std::sin(angle));
 }
 
-Arc Bulge::toArc() const
+double Bulge::closestPointRatio(const Vector2D &point) const
 {
+	if (isLine()) {
+		const Vector2D line = m_end - m_start;
+		const double lengthSquared = line.lengthSquared();
+		if (lengthSquared == 0.0) {
+			return 0.0;
+		}
+
+		return std::clamp(Vector2D::dotProduct(point - m_start, line) / lengthSquared, 0.0, 1.0);
+	}
+
 	const Circle circle = toCircle();
-	const QVector2D &center = circle.center();
+	const Vector2D &center = circle.center();
 
-	const float startAngle = LineAngle(m_start - center);
-	const float endAngle = LineAngle(m_end - center);
+	const double spanAngle = 4.0 * std::atan(std::abs(m_tangent));
+	const double startAngle = LineAngle(m_start - center);
+	const double pointAngle = LineAngle(point - center);
+	// Angle from start to point following arc direction
+	const double deltaAngle = (orientation() == Orientation::CCW) ? DeltaAngle(startAngle, pointAngle) : DeltaAngle(pointAngle, startAngle);
 
-	return Arc(circle, m_start, m_end, startAngle, endAngle);
+	if (deltaAngle <= spanAngle) {
+		return deltaAngle / spanAngle;
+	}
+
+	// Point projection is outside of the arc, closest point is one of the ends
+	return (point.distanceToPoint(m_start) <= point.distanceToPoint(m_end)) ? 0.0 : 1.0;
 }
 
-inline QVector2D mapVector2D(const QVector2D &vect, const QTransform &matrix)
+Bulge::Pair Bulge::split(double t) const
 {
-	const QPointF point = vect.toPointF();
-	return QVector2D(matrix.map(point));
+	assert(0.0 < t && t < 1.0);
+
+	const Vector2D middle = pointAt(t);
+	const double angle = 4.0 * std::atan(m_tangent);
+
+	const Bulge b1(m_start, middle, std::tan(angle * t / 4.0));
+	const Bulge b2(middle, m_end, std::tan(angle * (1.0 - t) / 4.0));
+
+	return {b1, b2};
 }
 
-void Bulge::transform(const QTransform &matrix)
+double Bulge::distanceToPoint(const Vector2D &point) const
 {
-	m_start = mapVector2D(m_start, matrix);
-	m_end = mapVector2D(m_end, matrix);
+	return point.distanceToPoint(pointAt(closestPointRatio(point)));
+}
 
-	if (matrix.isScaling()) {
-		const bool invertTagent = (matrix.m11() * matrix.m22()) < 0.0f;
-		if (invertTagent) {
-			m_tangent = -m_tangent;
+bool Bulge::crossesSegment(const Vector2D &start, const Vector2D &end) const
+{
+	if (isLine()) {
+		// Ends of each segment are on both sides of the other segment
+		const bool crossesLine = (CrossProduct(m_start, m_end, start) * CrossProduct(m_start, m_end, end)) <= 0.0;
+		const bool crossesSegment = (CrossProduct(start, end, m_start) * CrossProduct(start, end, m_end)) <= 0.0;
+		return crossesLine && crossesSegment;
+	}
+
+	const Circle circle = toCircle();
+	const Vector2D &center = circle.center();
+	const double radius = circle.radius();
+
+	// Solve |start + t * (end - start) - center| = radius
+	const Vector2D direction = end - start;
+	const Vector2D relativeStart = start - center;
+	const double a = direction.lengthSquared();
+	const double b = 2.0 * Vector2D::dotProduct(relativeStart, direction);
+	const double c = relativeStart.lengthSquared() - radius * radius;
+	const double discriminant = b * b - 4.0 * a * c;
+	if (a == 0.0 || discriminant < 0.0) {
+		return false;
+	}
+
+	// Arc seen counter clockwise
+	const double startAngle = LineAngle(((m_tangent > 0.0) ? m_start : m_end) - center);
+	const double spanAngle = 4.0 * std::atan(std::abs(m_tangent));
+
+	const double root = std::sqrt(discriminant);
+	for (const double t : {(-b - root) / (2.0 * a), (-b + root) / (2.0 * a)}) {
+		if (0.0 <= t && t <= 1.0) {
+			const Vector2D intersection = start + t * direction;
+			if (DeltaAngle(startAngle, LineAngle(intersection - center)) <= spanAngle) {
+				return true;
+			}
 		}
 	}
+
+	return false;
+}
+
+Rect Bulge::boundingRect() const
+{
+	Rect rect(m_start, m_end);
+
+	if (isArc()) {
+		const Circle circle = toCircle();
+		const Vector2D &center = circle.center();
+		const double radius = circle.radius();
+
+		// Arc seen counter clockwise
+		const double startAngle = LineAngle(((m_tangent > 0.0) ? m_start : m_end) - center);
+		const double spanAngle = 4.0 * std::atan(std::abs(m_tangent));
+
+		// Extreme points of the circle on each axis
+		const Vector2D extremes[] = {Vector2D(1.0, 0.0), Vector2D(0.0, 1.0), Vector2D(-1.0, 0.0), Vector2D(0.0, -1.0)};
+		for (const Vector2D &extreme : extremes) {
+			if (DeltaAngle(startAngle, LineAngle(extreme)) <= spanAngle) {
+				rect |= center + radius * extreme;
+			}
+		}
+	}
+
+	return rect;
+}
+
+bool Bulge::intersects(const Rect &rect) const
+{
+	if (rect.contains(m_start) || rect.contains(m_end)) {
+		return true;
+	}
+
+	if (!rect.intersects(boundingRect())) {
+		return false;
+	}
+
+	// Both ends are outside, bulge can only enter rectangle by crossing one of its sides
+	const Vector2D &min = rect.min();
+	const Vector2D &max = rect.max();
+	const Vector2D corners[] = {min, Vector2D(max.x(), min.y()), max, Vector2D(min.x(), max.y())};
+	for (int i = 0; i < 4; ++i) {
+		if (crossesSegment(corners[i], corners[(i + 1) % 4])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int Bulge::crossingCount(const Vector2D &point) const
+{
+	// Count crossing of a piece monotone on y axis, x is given for the crossing at point height.
+	const auto pieceCrossing = [&point](const Vector2D &start, const Vector2D &end, double x) {
+		const bool startAbove = start.y() > point.y();
+		const bool endAbove = end.y() > point.y();
+		return (startAbove != endAbove && x > point.x()) ? 1 : 0;
+	};
+
+	if (isLine()) {
+		if (m_start.y() == m_end.y()) {
+			return 0;
+		}
+
+		const double t = (point.y() - m_start.y()) / (m_end.y() - m_start.y());
+		return pieceCrossing(m_start, m_end, m_start.x() + t * (m_end.x() - m_start.x()));
+	}
+
+	const Circle circle = toCircle();
+	const Vector2D &center = circle.center();
+	const double radius = circle.radius();
+	const double dy = point.y() - center.y();
+	const double dx = std::sqrt(std::max(0.0, radius * radius - dy * dy));
+
+	// Crossing count doesn't depend on direction, walk arc counter clockwise.
+	const Vector2D &start = (m_tangent > 0.0) ? m_start : m_end;
+	const Vector2D &end = (m_tangent > 0.0) ? m_end : m_start;
+	const double startAngle = LineAngle(start - center);
+	const double endAngle = startAngle + 4.0 * std::atan(std::abs(m_tangent));
+
+	// Split arc in y monotone pieces at top and bottom of the circle.
+	int count = 0;
+	Vector2D pieceStart = start;
+	double pieceStartAngle = startAngle;
+	for (double angle = M_PI_2 + std::ceil((startAngle - M_PI_2) / M_PI) * M_PI; angle < endAngle; angle += M_PI) {
+		if (angle <= pieceStartAngle) {
+			continue;
+		}
+
+		const Vector2D pieceEnd = center + Vector2D(0.0, (std::sin(angle) > 0.0) ? radius : -radius);
+		const double side = std::cos((pieceStartAngle + angle) / 2.0);
+		count += pieceCrossing(pieceStart, pieceEnd, center.x() + std::copysign(dx, side));
+
+		pieceStart = pieceEnd;
+		pieceStartAngle = angle;
+	}
+
+	const double side = std::cos((pieceStartAngle + endAngle) / 2.0);
+	count += pieceCrossing(pieceStart, end, center.x() + std::copysign(dx, side));
+
+	return count;
+}
+
+void Bulge::transform(const Transform &matrix)
+{
+	m_start = matrix.map(m_start);
+	m_end = matrix.map(m_end);
+
+	if (matrix.isMirroring()) {
+		m_tangent = -m_tangent;
+	}
 }
 
 bool Bulge::operator==(const Bulge& other) const
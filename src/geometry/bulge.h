@@ -4,14 +4,15 @@
 
 #include <geometry/arc.h>
 #include <geometry/circle.h>
+#include <geometry/rect.h>
 #include <geometry/utils.h>
 
 #include <cavc/plinesegment.hpp>
 
 #include <serializer/access.h>
 
-#include <QVector2D>
-#include <QTransform>
+#include <geometry/vector2d.h>
+#include <geometry/transform.h>
 
 namespace geometry
 {
@@ -21,10 +22,13 @@ class Bulge : public common::Aggregable<Bulge>
 	friend serializer::Access<Bulge>;
 
 private:
-	QVector2D m_start;
-	QVector2D m_end;
+	Vector2D m_start;
+	Vector2D m_end;
 
-	float m_tangent;
+	double m_tangent;
+
+	/// Test if bulge crosses or touches a segment
+	bool crossesSegment(const Vector2D &start, const Vector2D &end) const;
 
 public:
 	/** Define a bulge
@@ -34,18 +38,18 @@ public:
 	 * Negative tangent means the arc goes clockwise from start to end,
 	 * otherwise anti clockwise from start to end.
 	 */
-	explicit Bulge(const QVector2D &start, const QVector2D &end, float tangent);
+	explicit Bulge(const Vector2D &start, const Vector2D &end, double tangent);
 	explicit Bulge(const cavc::PlineVertex<double> &v1, const cavc::PlineVertex<double> &v2);
 	explicit Bulge() = default;
 
-	const QVector2D &start() const;
-	QVector2D &start();
-	const QVector2D &end() const;
-	QVector2D &end();
-	float tangent() const;
-	float &tangent();
+	const Vector2D &start() const;
+	Vector2D &start();
+	const Vector2D &end() const;
+	Vector2D &end();
+	double tangent() const;
+	double &tangent();
 
-	float length() const;
+	double length() const;
 
 	/// Change direction
 	void invert();
@@ -53,9 +57,9 @@ public:
 	void linify();
 
 	// Extend bulge start point
-	Bulge extendStart(const QVector2D &start) const;
+	Bulge extendStart(const Vector2D &start) const;
 	// Extend bulge end point
-	Bulge extendEnd(const QVector2D &end) const;
+	Bulge extendEnd(const Vector2D &end) const;
 
 	bool isLine() const;
 	bool isArc() const;
@@ -64,7 +68,25 @@ public:
 	Circle toCircle() const;
 	Arc toArc() const;
 
-	void transform(const QTransform &matrix);
+	/// Point at ratio t of the bulge length, 0 being start and 1 end
+	Vector2D pointAt(double t) const;
+	/// Ratio of the bulge length at closest point on bulge from a point
+	double closestPointRatio(const Vector2D &point) const;
+	/// Split bulge in two at ratio t of its length
+	Pair split(double t) const;
+	/// Distance from a point to its closest point on bulge
+	double distanceToPoint(const Vector2D &point) const;
+
+	Rect boundingRect() const;
+	/// Test if any point of the bulge is inside a rectangle
+	bool intersects(const Rect &rect) const;
+	/** Number of crossings of the bulge with the horizontal half line starting from point
+	 * toward positive x. Ends lying on the half line are considered below it, so that summing
+	 * over bulges of a closed polyline counts shared vertices once.
+	 */
+	int crossingCount(const Vector2D &point) const;
+
+	void transform(const Transform &matrix);
 
 	bool operator==(const Bulge& other) const;
 };
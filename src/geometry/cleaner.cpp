@@ -1,138 +1,495 @@
 #include <cleaner.h>
 
-#include <iterator>
+#include <common/parallel.h>
+
+#include <cmath>
+#include <optional>
+#include <vector>
 
-#include <QDebug> // TODO
 
 namespace geometry
 {
 
-template<typename T>
-typename std::vector<T>::iterator insertSortedReverse(std::vector<T> &vec, const T &item)
-{
-    return vec.insert(std::upper_bound(vec.begin(), vec.end(), item, std::greater<T>()), item);
-}
-
-class PolylineLengthCleaner
+/** @brief Bulges to merge ordered by length, smallest first.
+ * Binary min heap of bulge indices keeping position of every bulge in heap,
+ * allowing to update or remove any bulge in logarithmic time.
+ */
+class MergeQueue
 {
 private:
-	using BulgeLinkedList = std::list<Bulge>;
-
-	struct Item : common::Aggregable<Item>
+	struct Key
 	{
-		BulgeLinkedList::iterator it;
-		float length;
+		double length;
+		/// Insertion order, on equal lengths the latest inserted bulge is merged first
+		int stamp;
 
-		explicit Item(BulgeLinkedList::iterator _it, float _length)
-			:it(_it),
-			length(_length)
+		bool operator<(const Key &other) const
 		{
+			return (length < other.length) || (length == other.length && stamp > other.stamp);
 		}
+	};
 
-		bool operator>(const Item &other) const
-		{
-			return length > other.length;
+	std::vector<int> m_heap;
+	/// Position of bulges in heap, -1 if absent
+	std::vector<int> m_positions;
+	std::vector<Key> m_keys;
+	int m_nextStamp;
+
+	bool less(int position1, int position2) const
+	{
+		return m_keys[m_heap[position1]] < m_keys[m_heap[position2]];
+	}
+
+	void swap(int position1, int position2)
+	{
+		std::swap(m_heap[position1], m_heap[position2]);
+		m_positions[m_heap[position1]] = position1;
+		m_positions[m_heap[position2]] = position2;
+	}
+
+	void siftUp(int position)
+	{
+		while (position > 0) {
+			const int parent = (position - 1) / 2;
+			if (!less(position, parent)) {
+				break;
+			}
+			swap(position, parent);
+			position = parent;
 		}
-	};
+	}
 
-	const Polyline &m_polyline;
+	void siftDown(int position)
+	{
+		const int size = m_heap.size();
+		while (true) {
+			const int left = position * 2 + 1;
+			const int right = left + 1;
+			int smallest = position;
+
+			if (left < size && less(left, smallest)) {
+				smallest = left;
+			}
+			if (right < size && less(right, smallest)) {
+				smallest = right;
+			}
+			if (smallest == position) {
+				break;
+			}
+			swap(position, smallest);
+			position = smallest;
+		}
+	}
+
+public:
+	explicit MergeQueue(int bulgeCount)
+		:m_positions(bulgeCount, -1),
+		m_keys(bulgeCount),
+		m_nextStamp(0)
+	{
+	}
+
+	bool empty() const
+	{
+		return m_heap.empty();
+	}
+
+	/// Insert a bulge or update its length if already present
+	void push(int index, double length)
+	{
+		m_keys[index] = {length, m_nextStamp++};
+
+		const int position = m_positions[index];
+		if (position == -1) {
+			m_positions[index] = m_heap.size();
+			m_heap.push_back(index);
+			siftUp(m_heap.size() - 1);
+		}
+		else {
+			siftUp(position);
+			siftDown(m_positions[index]);
+		}
+	}
+
+	int pop()
+	{
+		const int index = m_heap.front();
+		remove(index);
+
+		return index;
+	}
+
+	/// Remove a bulge if present
+	void remove(int index)
+	{
+		const int position = m_positions[index];
+		if (position == -1) {
+			return;
+		}
+
+		const int last = m_heap.size() - 1;
+		swap(position, last);
+		m_heap.pop_back();
+		m_positions[index] = -1;
+
+		// Restore heap order around the bulge moved from last position
+		if (position != last) {
+			const int moved = m_heap[position];
+			siftUp(position);
+			siftDown(m_positions[moved]);
+		}
+	}
+};
+
+/** @brief Merge bulges smaller than a minimum length into their neighbour, smallest first.
+ * Bulges are stored contiguously and linked by indices, removed bulges are skipped by links.
+ */
+class PolylineLengthCleaner
+{
+private:
 	const float m_minimumPolylineLength;
+	const Polyline &m_polyline;
+
+	Bulge::List m_bulges;
+	/// Index of previous bulge, -1 for first one
+	std::vector<int> m_previous;
+	/// Index of next bulge, -1 for last one
+	std::vector<int> m_next;
+	int m_first;
+	int m_size;
 
-	BulgeLinkedList m_bulges;
-	Item::List m_itemsToMerge;
+	MergeQueue m_queue;
 
 	void constructLinkedList()
 	{
-		m_polyline.forEachBulge([this](const Bulge &bulge){
-			m_bulges.push_back(bulge);
-		});
+		m_previous.resize(m_size);
+		m_next.resize(m_size);
+		for (int index = 0; index < m_size; ++index) {
+			m_previous[index] = index - 1;
+			m_next[index] = (index + 1 < m_size) ? index + 1 : -1;
+		}
 	}
 
 	void initBulgesToMerge()
 	{
 		// Add every small bulges
-		for (BulgeLinkedList::iterator it = m_bulges.begin(), end = m_bulges.end(); it != end; ++it) {
-			const float length = it->length();
+		for (int index = 0; index < m_size; ++index) {
+			const double length = m_bulges[index].length();
 			if (length < m_minimumPolylineLength) {
-				m_itemsToMerge.emplace_back(it, length);
+				m_queue.push(index, length);
 			}
 		}
-
-		// Sort small bulges by length in descending order
-		std::sort(m_itemsToMerge.begin(), m_itemsToMerge.end(), std::greater<Item>());
 	}
 
-	BulgeLinkedList::iterator extendNeighbourBulge(const BulgeLinkedList::iterator &it)
+	int extendNeighbourBulge(int index)
 	{
-		BulgeLinkedList::iterator neighbourIt;
+		const Bulge &bulge = m_bulges[index];
+		int neighbour;
 
 		// Find neighbour bulge and extend it to overlap removed bulge.
-		if (it == m_bulges.begin()) {
-			neighbourIt = std::next(it);
+		if (index == m_first) {
+			neighbour = m_next[index];
 			// Replace neighbour bulge with its extended version
-			*neighbourIt = neighbourIt->extendStart(it->start());
+			m_bulges[neighbour] = m_bulges[neighbour].extendStart(bulge.start());
 		}
 		else {
-			neighbourIt = std::prev(it);
+			neighbour = m_previous[index];
 			// Replace neighbour bulge with its extended version
-			*neighbourIt = neighbourIt->extendEnd(it->end());
+			m_bulges[neighbour] = m_bulges[neighbour].extendEnd(bulge.end());
 		}
 
-		return neighbourIt;
+		return neighbour;
 	}
 
-	void removeAssociatedItem(const BulgeLinkedList::iterator &it)
+	void unlink(int index)
 	{
-		// Look for item associated to neighbour bulge
-		Item::List::iterator itemIt = std::find_if(m_itemsToMerge.begin(), m_itemsToMerge.end(),
-				[&it](const Item &item) { return item.it == it; });
+		const int previous = m_previous[index];
+		const int next = m_next[index];
+
+		if (previous == -1) {
+			m_first = next;
+		}
+		else {
+			m_next[previous] = next;
+		}
 
-		// Remove this item.
-		if (itemIt != m_itemsToMerge.end()) {
-			m_itemsToMerge.erase(itemIt);
+		if (next != -1) {
+			m_previous[next] = previous;
 		}
+
+		--m_size;
 	}
 
-	void mergeItem(const Item &item)
+	void mergeBulge(int index)
 	{
-		const BulgeLinkedList::iterator &it = item.it;
 		// Extend neighbour to overlap and retrieve its position
-		const BulgeLinkedList::iterator neighbourIt = extendNeighbourBulge(it);
+		const int neighbour = extendNeighbourBulge(index);
 
 		// Remove smallest bulge.
-		m_bulges.erase(it);
-
-		// Try remove associated item to neighbour bulge
-		removeAssociatedItem(neighbourIt);
+		unlink(index);
 
-		const float length = neighbourIt->length();
-		// Reinsert extended bulge if still need to be merged.
+		const double length = m_bulges[neighbour].length();
+		// Update extended bulge if still need to be merged.
 		if (length < m_minimumPolylineLength) {
-			insertSortedReverse(m_itemsToMerge, Item(neighbourIt, length));
+			m_queue.push(neighbour, length);
+		}
+		else {
+			m_queue.remove(neighbour);
 		}
 	}
 
 public:
 	explicit PolylineLengthCleaner(const Polyline &polyline, float minimumPolylineLength)
-		:m_polyline(polyline),
-		m_minimumPolylineLength(minimumPolylineLength)
+		:m_minimumPolylineLength(minimumPolylineLength),
+		m_polyline(polyline),
+		m_bulges(polyline.bulges()),
+		m_first(0),
+		m_size(m_bulges.size()),
+		m_queue(m_size)
 	{
 		constructLinkedList();
 
 		initBulgesToMerge();
 
 		// Merge all bulges but avoid emptying the polyline, for instance polylines representing a point
-		while (!m_itemsToMerge.empty() && m_bulges.size() > 1) {
-			Item item = m_itemsToMerge.back();
-			m_itemsToMerge.pop_back();
-
-			mergeItem(item);
+		while (!m_queue.empty() && m_size > 1) {
+			mergeBulge(m_queue.pop());
 		}
 	}
 
 	Polyline polyline() const
 	{
-		return Polyline(Bulge::List(m_bulges.begin(), m_bulges.end()));
+		// Share vertices of unchanged polyline
+		if (m_size == (int)m_bulges.size()) {
+			return m_polyline;
+		}
+
+		Bulge::List bulges;
+		bulges.reserve(m_size);
+		for (int index = m_first; index != -1; index = m_next[index]) {
+			bulges.push_back(m_bulges[index]);
+		}
+
+		return Polyline(bulges);
+	}
+};
+
+/** @brief Replace runs of consecutive lines by a single line when they are collinear, or by an arc
+ * when they follow a circle, within a tolerance.
+ * Lines of tessellated curves are merged this way into few bulges. From each line, the longest
+ * collinear run and the longest arc run are searched, the longest one is kept, lines on ties.
+ * Arcs continuing smoothly the previous bulge must start on its end tangent.
+ */
+class FittingCleaner
+{
+private:
+	/// Minimum number of lines replaced by an arc
+	static constexpr int MinimumArcLineCount = 3;
+
+	const float m_tolerance;
+	const Bulge::List m_bulges;
+
+	Bulge::List m_fittedBulges;
+
+	/// Direction angle of a bulge at its start
+	static double startAngle(const Bulge &bulge)
+	{
+		return LineAngle(bulge.end() - bulge.start()) - 2.0 * std::atan(bulge.tangent());
+	}
+
+	/// Direction angle of a bulge at its end
+	static double endAngle(const Bulge &bulge)
+	{
+		return LineAngle(bulge.end() - bulge.start()) + 2.0 * std::atan(bulge.tangent());
+	}
+
+	/// Signed angle from an angle to another in [-pi, pi]
+	static double angleBetween(double from, double to)
+	{
+		return std::remainder(to - from, 2.0 * M_PI);
+	}
+
+	/** Last index of the longest run accepted by fits, from minimum last up to run end excluded,
+	 * or minimum last - 1 if none. Runs are grown exponentially then bisected, assuming that
+	 * shorter runs of an accepted run are also accepted. Fit tolerance doesn't guarantee it
+	 * for arcs, a longer accepted run may then be missed but returned run was always accepted
+	 * by a call of fits.
+	 */
+	template <class Fits>
+	static int longestRun(int minimumLast, int runEnd, Fits &&fits)
+	{
+		if (minimumLast >= runEnd || !fits(minimumLast)) {
+			return minimumLast - 1;
+		}
+
+		int accepted = minimumLast;
+		int rejected = runEnd;
+		for (int step = 1; accepted + step < runEnd; step *= 2) {
+			if (!fits(accepted + step)) {
+				rejected = accepted + step;
+				break;
+			}
+			accepted += step;
+		}
+
+		while (rejected - accepted > 1) {
+			const int middle = (accepted + rejected) / 2;
+			if (fits(middle)) {
+				accepted = middle;
+			}
+			else {
+				rejected = middle;
+			}
+		}
+
+		return accepted;
+	}
+
+	/// Index following the run of lines starting at first
+	int lineRunEnd(int first) const
+	{
+		int end = first;
+		while (end < (int)m_bulges.size() && m_bulges[end].isLine()) {
+			++end;
+		}
+
+		return end;
+	}
+
+	bool fitsLine(int first, int last) const
+	{
+		const Vector2D &start = m_bulges[first].start();
+		const Vector2D chord = m_bulges[last].end() - start;
+		const double length = chord.length();
+		if (length == 0.0) {
+			return false;
+		}
+
+		const Vector2D direction = chord / length;
+
+		// Inner points must be close to chord and move forward on it
+		double previousProjection = 0.0;
+		for (int index = first; index < last; ++index) {
+			const Vector2D relative = m_bulges[index].end() - start;
+			const double deviation = direction.x() * relative.y() - direction.y() * relative.x();
+			const double projection = Vector2D::dotProduct(direction, relative);
+
+			if (std::abs(deviation) > m_tolerance || projection <= previousProjection || projection >= length) {
+				return false;
+			}
+			previousProjection = projection;
+		}
+
+		return true;
+	}
+
+	std::optional<Bulge> fitArc(int first, int last) const
+	{
+		const int count = last - first + 1;
+		if (count < MinimumArcLineCount) {
+			return std::nullopt;
+		}
+
+		const Vector2D &start = m_bulges[first].start();
+		const Vector2D &middle = m_bulges[first + count / 2].start();
+		const Vector2D &end = m_bulges[last].end();
+
+		const std::optional<Vector2D> center = CircleCenter(start, middle, end);
+		if (!center) {
+			return std::nullopt;
+		}
+
+		const double radius = start.distanceToPoint(*center);
+		const double sign = (CrossProduct(start, middle, end) > 0.0) ? 1.0 : -1.0;
+		const auto onCircle = [this, &center, radius](const Vector2D &point){
+			return std::abs(point.distanceToPoint(*center) - radius) <= m_tolerance;
+		};
+
+		double spanAngle = 0.0;
+		double firstAngle = 0.0;
+		for (int index = first; index <= last; ++index) {
+			const Bulge &line = m_bulges[index];
+			if (!onCircle(line.end()) || !onCircle((line.start() + line.end()) / 2.0)) {
+				return std::nullopt;
+			}
+
+			// Every line must turn around center in arc direction
+			const Vector2D from = line.start() - *center;
+			const Vector2D to = line.end() - *center;
+			const double angle = std::atan2(from.x() * to.y() - from.y() * to.x(), Vector2D::dotProduct(from, to));
+			if (angle * sign <= 0.0 || std::abs(angle) >= M_PI_2) {
+				return std::nullopt;
+			}
+
+			spanAngle += std::abs(angle);
+			if (index == first) {
+				firstAngle = std::abs(angle);
+			}
+		}
+
+		// Bulge tangent is limited to 1, meaning half circle, accept accumulated rounding errors.
+		constexpr double spanAngleTolerance = 1e-4;
+		if (spanAngle > M_PI + spanAngleTolerance) {
+			return std::nullopt;
+		}
+
+		const double tangent = std::min(1.0, std::tan(spanAngle / 4.0));
+		const Bulge arc(start, end, sign * tangent);
+
+		if (!m_fittedBulges.empty()) {
+			// Previous bulge and first line meet smoothly when their angle is below twice the tessellation step
+			const Bulge &previous = m_fittedBulges.back();
+			const double previousAngle = endAngle(previous);
+			const double jointAngle = std::abs(angleBetween(previousAngle, startAngle(m_bulges[first])));
+
+			// Tangent error moving arc by tolerance over first line
+			const double tangentTolerance = m_tolerance / m_bulges[first].length();
+			if (jointAngle <= 2.0 * firstAngle && std::abs(angleBetween(previousAngle, startAngle(arc))) > tangentTolerance) {
+				return std::nullopt;
+			}
+		}
+
+		return std::make_optional(arc);
+	}
+
+public:
+	explicit FittingCleaner(const Polyline &polyline, float tolerance)
+		:m_tolerance(tolerance),
+		m_bulges(polyline.bulges())
+	{
+		for (int index = 0, size = m_bulges.size(); index < size;) {
+			const Bulge &bulge = m_bulges[index];
+			if (bulge.isArc()) {
+				m_fittedBulges.push_back(bulge);
+				++index;
+				continue;
+			}
+
+			const int runEnd = lineRunEnd(index);
+
+			const int lineLast = longestRun(index + 1, runEnd, [this, index](int last){
+				return fitsLine(index, last);
+			});
+
+			const int arcMinimumLast = index + MinimumArcLineCount - 1;
+			const int arcLast = longestRun(arcMinimumLast, runEnd, [this, index](int last){
+				return fitArc(index, last).has_value();
+			});
+
+			if (arcLast >= arcMinimumLast && arcLast > lineLast) {
+				m_fittedBulges.push_back(*fitArc(index, arcLast));
+				index = arcLast + 1;
+			}
+			else {
+				m_fittedBulges.emplace_back(bulge.start(), m_bulges[lineLast].end(), 0.0f);
+				index = lineLast + 1;
+			}
+		}
+	}
+
+	Polyline polyline()
+	{
+		return Polyline(m_fittedBulges);
 	}
 };
 
@@ -143,13 +500,25 @@ private:
 
 public:
 	explicit ArcLengthCleaner(Polyline &&polyline, float minimumArcLength)
-		:m_polyline(polyline)
+		:m_polyline(std::move(polyline))
 	{
-		m_polyline.transformBulge([minimumArcLength](Bulge &bulge){
-			if (bulge.isArc() && bulge.length() < minimumArcLength) {
-				bulge.linify();
-			}
+		const auto isSmallArc = [minimumArcLength](const Bulge &bulge){
+			return bulge.isArc() && bulge.length() < minimumArcLength;
+		};
+
+		// Rebuild vertices only when an arc is converted
+		bool hasSmallArc = false;
+		m_polyline.forEachBulge([&hasSmallArc, &isSmallArc](const Bulge &bulge){
+			hasSmallArc |= isSmallArc(bulge);
 		});
+
+		if (hasSmallArc) {
+			m_polyline.transformBulge([&isSmallArc](Bulge &bulge){
+				if (isSmallArc(bulge)) {
+					bulge.linify();
+				}
+			});
+		}
 	}
 
 	Polyline &&polyline()
@@ -158,17 +527,26 @@ public:
 	}
 };
 
-Cleaner::Cleaner(Polyline::List &&polylines, float minimumPolylineLength, float minimumArcLength)
+Cleaner::Cleaner(Polyline::List &&polylines, float minimumPolylineLength, float minimumArcLength, float fittingTolerance)
+	:m_polylines(polylines.size())
 {
-	for (const Polyline &polyline : polylines) {
+	// Polylines are cleaned independently
+	common::parallelFor(polylines.size(), [this, &polylines, minimumPolylineLength, minimumArcLength, fittingTolerance](size_t index){
 		// Prune small polyline length
-		PolylineLengthCleaner lengthCleaner(polyline, minimumPolylineLength);
+		PolylineLengthCleaner lengthCleaner(polylines[index], minimumPolylineLength);
+		Polyline cleanedPolyline = lengthCleaner.polyline();
+
+		// Merge collinear lines and fit arcs on tessellated curves
+		if (fittingTolerance > 0.0f) {
+			FittingCleaner fittingCleaner(cleanedPolyline, fittingTolerance);
+			cleanedPolyline = fittingCleaner.polyline();
+		}
 
 		// Convert small arcs to lines
-		ArcLengthCleaner arcCleaner(lengthCleaner.polyline(), minimumArcLength);
+		ArcLengthCleaner arcCleaner(std::move(cleanedPolyline), minimumArcLength);
 
-		m_polylines.push_back(arcCleaner.polyline());
-	}
+		m_polylines[index] = arcCleaner.polyline();
+	});
 }
 
 Polyline::List &&Cleaner::polylines()
@@ -5,7 +5,8 @@
 namespace geometry
 {
 
-/** @brief Clean polyline via merging of small bulges.
+/** @brief Clean polyline via merging of small bulges and optionally fitting
+ * lines and arcs on runs of lines.
  */
 class Cleaner
 {
@@ -13,7 +14,11 @@ private:
 	Polyline::List m_polylines;
 
 public:
-	explicit Cleaner(Polyline::List &&polylines, float minimumPolylineLength, float minimumArcLength);
+	/** Clean polylines
+	 * @param fittingTolerance Maximum distance between replaced lines and fitted line or arc,
+	 * fitting is disabled when zero.
+	 */
+	explicit Cleaner(Polyline::List &&polylines, float minimumPolylineLength, float minimumArcLength, float fittingTolerance = 0.0f);
 
 	Polyline::List &&polylines();
 };
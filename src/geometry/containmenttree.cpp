@@ -0,0 +1,99 @@
+#include <containmenttree.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace geometry
+{
+
+bool ContainmentTree::contains(int outer, int inner) const
+{
+	return m_boundingRects[outer].contains(m_boundingRects[inner]) &&
+		m_polylines[outer]->contains(m_polylines[inner]->start());
+}
+
+void ContainmentTree::insert(int index)
+{
+	int parent = -1;
+	const std::vector<int> *siblings = &m_roots;
+
+	// Descend into the first child containing polyline
+	for (bool found = true; found;) {
+		found = false;
+		for (const int sibling : *siblings) {
+			if (contains(sibling, index)) {
+				parent = sibling;
+				siblings = &m_nodes[sibling].children;
+				found = true;
+				break;
+			}
+		}
+	}
+
+	Node &node = m_nodes[index];
+	node.parent = parent;
+	if (parent == -1) {
+		m_roots.push_back(index);
+	}
+	else {
+		node.depth = m_nodes[parent].depth + 1;
+		m_nodes[parent].children.push_back(index);
+	}
+}
+
+ContainmentTree::ContainmentTree(const Polyline::ListCPtr &polylines)
+	:m_polylines(polylines),
+	m_boundingRects(polylines.size()),
+	m_nodes(polylines.size())
+{
+	std::transform(m_polylines.begin(), m_polylines.end(), m_boundingRects.begin(), [](const Polyline *polyline){
+		assert(polyline->isClosed() && !polyline->isPoint());
+		return polyline->boundingRect();
+	});
+
+	// A polyline can only be contained by a polyline with a larger bounding rectangle.
+	std::vector<int> order(m_polylines.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](int index1, int index2){
+		return m_boundingRects[index1].area() > m_boundingRects[index2].area();
+	});
+
+	for (const int index : order) {
+		insert(index);
+	}
+}
+
+const std::vector<int> &ContainmentTree::roots() const
+{
+	return m_roots;
+}
+
+int ContainmentTree::parent(int index) const
+{
+	return m_nodes[index].parent;
+}
+
+int ContainmentTree::depth(int index) const
+{
+	return m_nodes[index].depth;
+}
+
+const std::vector<int> &ContainmentTree::children(int index) const
+{
+	return m_nodes[index].children;
+}
+
+ContainmentTree::Region::List ContainmentTree::regions() const
+{
+	Region::List regions;
+	for (int index = 0, size = m_nodes.size(); index < size; ++index) {
+		const Node &node = m_nodes[index];
+		if ((node.depth % 2) == 0) {
+			regions.push_back({{}, index, node.children});
+		}
+	}
+
+	return regions;
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <geometry/polyline.h>
+#include <geometry/rect.h>
+
+namespace geometry
+{
+
+/** @brief Hierarchy of closed polylines where parent of a polyline is the smallest polyline
+ * containing it.
+ * Polylines are inserted by decreasing bounding rectangle area, descending from roots into
+ * the first node containing the inserted polyline. Containment is first checked on bounding
+ * rectangles then by point in polygon test of the inserted polyline start.
+ */
+class ContainmentTree
+{
+public:
+	/// Area to pocket, bounded by a border and excluding islands
+	struct Region : common::Aggregable<Region>
+	{
+		/// Index of border polyline
+		int border;
+		/// Indices of islands polylines
+		std::vector<int> islands;
+	};
+
+private:
+	struct Node
+	{
+		int parent = -1;
+		int depth = 0;
+		std::vector<int> children;
+	};
+
+	const Polyline::ListCPtr &m_polylines;
+	Rect::List m_boundingRects;
+	std::vector<Node> m_nodes;
+	std::vector<int> m_roots;
+
+	bool contains(int outer, int inner) const;
+	void insert(int index);
+
+public:
+	/** Build tree from closed polylines
+	 * @param polylines Closed and non point polylines, must outlive tree.
+	 */
+	explicit ContainmentTree(const Polyline::ListCPtr &polylines);
+
+	/// Indices of polylines contained by none
+	const std::vector<int> &roots() const;
+	/// Index of smallest polyline containing polyline at index, -1 if none
+	int parent(int index) const;
+	/// Number of polylines containing polyline at index
+	int depth(int index) const;
+	const std::vector<int> &children(int index) const;
+
+	/** Regions alternating from outside, polylines at even depth are borders
+	 * and their children are islands.
+	 */
+	Region::List regions() const;
+};
+
+}
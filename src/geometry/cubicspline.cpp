@@ -1,6 +1,5 @@
 #include <cubicspline.h>
 
-#include <QDebug>
 
 namespace geometry
 {
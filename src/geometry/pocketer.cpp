@@ -15,14 +15,14 @@ bool Pocketer::isBorderAndInslandsCapable() const
 
 cavc::OffsetLoop<double> Pocketer::polylineToLoop(const Polyline& polyline, Orientation expectedOrientation)
 {
-	const cavc::Polyline loop = polyline.toCavc(expectedOrientation);
-	return {0, loop, cavc::createApproxSpatialIndex(loop)};
+	const std::shared_ptr<const cavc::Polyline<double>> loop = polyline.toCavc(expectedOrientation);
+	return {0, *loop, cavc::createApproxSpatialIndex(*loop)};
 }
 
 cavc::OffsetLoop<double> Pocketer::polylineToLoop(const Polyline& polyline, bool inverse)
 {
-	const cavc::Polyline loop = inverse ? polyline.inverse().toCavc() :  polyline.toCavc();
-	return {0, loop, cavc::createApproxSpatialIndex(loop)};
+	const std::shared_ptr<const cavc::Polyline<double>> loop = inverse ? polyline.inverse().toCavc() :  polyline.toCavc();
+	return {0, *loop, cavc::createApproxSpatialIndex(*loop)};
 }
 
 Polyline Pocketer::loopToPolyline(const cavc::OffsetLoop<double> &loop)
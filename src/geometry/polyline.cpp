@@ -2,41 +2,146 @@
 #include <utils.h>
 #include <cavcutils.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace geometry
 {
 
-Polyline::Polyline(const cavc::Polyline<double> &polyline)
+/** Ends closer than CAVC geometric precision close the polyline, values
+ * computed by transformations or offsets are not bit exact.
+ */
+static bool areJoined(const Vector2D &start, const Vector2D &end)
 {
-	m_bulges.resize(polyline.isClosed() ? polyline.size() : polyline.size() - 1);
+	const double precision = cavc::utils::realPrecision<double>();
+	return (end - start).lengthSquared() <= precision * precision;
+}
 
-	polyline.visitSegIndices([&polyline, this](size_t i, size_t j){
-		m_bulges[i] = Bulge(polyline[i], polyline[j]);
-		return true;
-	});
+std::shared_ptr<cavc::Polyline<double>> Polyline::makeVertices(VertexList &&vertices, bool closed)
+{
+	assert(!vertices.empty());
+
+	const Vertex &first = vertices.front();
+	const Vertex &last = vertices.back();
+	if (!closed && vertices.size() > 1 && areJoined(Vector2D(first.x(), first.y()), Vector2D(last.x(), last.y()))) {
+		// Last vertex is implicit in closed polylines
+		vertices.pop_back();
+		closed = true;
+	}
+
+	if (!closed) {
+		vertices.back().bulge() = 0.0;
+	}
+
+	std::shared_ptr<cavc::Polyline<double>> polyline = std::make_shared<cavc::Polyline<double>>();
+	polyline->vertexes() = std::move(vertices);
+	polyline->isClosed() = closed;
+
+	return polyline;
 }
 
-cavc::Polyline<double> Polyline::toCavc() const
+int Polyline::vertexCount() const
 {
-	cavc::Polyline<double> ccPolyline;
+	return m_vertices ? m_vertices->size() : 0;
+}
 
-	// Convert to CAVC polyline
-	forEachBulge([&ccPolyline](const Bulge &bulge) {
-		const QVector2D &start = bulge.start();
-		ccPolyline.addVertex(start.x(), start.y(), bulge.tangent());
-	});
+Vector2D Polyline::pointAt(int index) const
+{
+	const VertexList &vertices = m_vertices->vertexes();
+	const int count = vertices.size();
+	// Reversed closed polylines keep their start vertex
+	const int storedIndex = m_reversed ? (m_vertices->isClosed() ? count - index : count - 1 - index) : index;
+	const Vertex &vertex = vertices[(storedIndex == count) ? 0 : storedIndex];
 
-	const bool closed = isClosed();
-	if (!closed) {
-		const QVector2D &endV = end();
-		ccPolyline.addVertex(endV.x(), endV.y(), 0.0f);
+	return Vector2D(vertex.x(), vertex.y());
+}
+
+double Polyline::tangentAt(int index) const
+{
+	const VertexList &vertices = m_vertices->vertexes();
+	// Reversed bulge i is stored bulge (count - 1 - i) going the other way
+	return m_reversed ? -vertices[bulgeCount() - 1 - index].bulge() : vertices[index].bulge();
+}
+
+Polyline::Vertex Polyline::vertexAt(int index) const
+{
+	const Vector2D point = pointAt(index);
+	// Last vertex of open polylines starts no bulge
+	return Vertex(point.x(), point.y(), (index < bulgeCount()) ? tangentAt(index) : 0.0);
+}
+
+Bulge Polyline::bulgeAt(int index) const
+{
+	return Bulge(pointAt(index), pointAt(index + 1), tangentAt(index));
+}
+
+cavc::Polyline<double> &Polyline::mutableVertices()
+{
+	invalidateCaches();
+
+	if (!m_vertices) {
+		// Default constructed polyline has no storage, reading it backward is the same
+		m_vertices = std::make_shared<cavc::Polyline<double>>();
+		m_reversed = false;
+	}
+	else if (m_reversed) {
+		VertexList vertices;
+		vertices.reserve(vertexCount());
+		for (int index = 0, count = vertexCount(); index < count; ++index) {
+			vertices.push_back(vertexAt(index));
+		}
+
+		m_vertices = makeVertices(std::move(vertices), isClosed());
+		m_reversed = false;
+	}
+	else if (m_vertices.use_count() > 1) {
+		m_vertices = std::make_shared<cavc::Polyline<double>>(*m_vertices);
+	}
+
+	return *m_vertices;
+}
+
+void Polyline::closeIfJoined()
+{
+	cavc::Polyline<double> &polyline = *m_vertices;
+	if (!polyline.isClosed() && polyline.size() > 1 && areJoined(start(), end())) {
+		polyline.vertexes().pop_back();
+		polyline.isClosed() = true;
 	}
+}
 
-	ccPolyline.isClosed() = closed;
+void Polyline::invalidateCaches()
+{
+	m_arcs.reset();
+	m_boundingRect.reset();
+}
+
+Polyline::Polyline(const cavc::Polyline<double> &polyline)
+	:m_vertices(std::make_shared<cavc::Polyline<double>>(polyline))
+{
+}
+
+Polyline::Polyline(cavc::Polyline<double> &&polyline)
+	:m_vertices(std::make_shared<cavc::Polyline<double>>(std::move(polyline)))
+{
+}
+
+std::shared_ptr<const cavc::Polyline<double>> Polyline::toCavc() const
+{
+	if (!m_reversed) {
+		return m_vertices;
+	}
+
+	VertexList vertices;
+	vertices.reserve(vertexCount());
+	for (int index = 0, count = vertexCount(); index < count; ++index) {
+		vertices.push_back(vertexAt(index));
+	}
 
-	return ccPolyline;
+	return makeVertices(std::move(vertices), isClosed());
 }
 
-cavc::Polyline<double> Polyline::toCavc(Orientation expectedOrientation) const
+std::shared_ptr<const cavc::Polyline<double>> Polyline::toCavc(Orientation expectedOrientation) const
 {
 	if (orientation() != expectedOrientation) {
 		return inverse().toCavc();
@@ -44,96 +149,206 @@ cavc::Polyline<double> Polyline::toCavc(Orientation expectedOrientation) const
 	return toCavc();
 }
 
-Polyline::Polyline(Bulge::List &&bulges)
-	:m_bulges(bulges)
+Polyline::Polyline(const Bulge::List &bulges)
 {
-	assert(!m_bulges.empty());
+	assert(!bulges.empty());
+
+	VertexList vertices;
+	vertices.reserve(bulges.size() + 1);
+	for (const Bulge &bulge : bulges) {
+		vertices.emplace_back(bulge.start().x(), bulge.start().y(), bulge.tangent());
+	}
+	vertices.emplace_back(bulges.back().end().x(), bulges.back().end().y(), 0.0);
+
+	m_vertices = makeVertices(std::move(vertices), false);
 }
 
-const QVector2D &Polyline::start() const
+Polyline::Polyline(VertexList &&vertices, bool closed)
+	:m_vertices(makeVertices(std::move(vertices), closed))
 {
-	assert(!m_bulges.empty());
+}
 
-	return m_bulges.front().start();
+Vector2D Polyline::start() const
+{
+	assert(vertexCount() > 0);
+
+	return pointAt(0);
 }
 
-QVector2D &Polyline::start()
+void Polyline::setStart(const Vector2D &start)
 {
-	assert(!m_bulges.empty());
+	assert(vertexCount() > 0);
+
+	Vertex &vertex = mutableVertices()[0];
+	vertex.x() = start.x();
+	vertex.y() = start.y();
 
-	return m_bulges.front().start();
+	closeIfJoined();
 }
 
-const QVector2D &Polyline::end() const
+Vector2D Polyline::end() const
 {
-	assert(!m_bulges.empty());
+	assert(vertexCount() > 0);
 
-	return m_bulges.back().end();
+	return pointAt(bulgeCount());
 }
 
-QVector2D &Polyline::end()
+void Polyline::setEnd(const Vector2D &end)
 {
-	assert(!m_bulges.empty());
+	assert(vertexCount() > 0);
 
-	return m_bulges.back().end();
+	cavc::Polyline<double> &polyline = mutableVertices();
+	Vertex &vertex = polyline.isClosed() ? polyline[0] : polyline.vertexes().back();
+	vertex.x() = end.x();
+	vertex.y() = end.y();
+
+	closeIfJoined();
 }
 
 bool Polyline::isClosed() const
 {
-	assert(!m_bulges.empty());
+	assert(vertexCount() > 0);
 
-	return (start() == end());
+	return m_vertices->isClosed();
 }
 
 bool Polyline::isPoint() const
 {
-	assert(!m_bulges.empty());
+	assert(vertexCount() > 0);
 
-	return isClosed() && (m_bulges.size() == 1);
+	return isClosed() && (bulgeCount() == 1);
 }
 
 bool Polyline::isLine() const
 {
-	assert(!m_bulges.empty());
+	assert(vertexCount() > 0);
 
-	return (m_bulges.size() == 1) && m_bulges.front().isLine();
+	return (bulgeCount() == 1) && (tangentAt(0) == 0.0);
 }
 
-float Polyline::length() const
+int Polyline::bulgeCount() const
 {
-	assert(!m_bulges.empty());
+	const int count = vertexCount();
+	if (count == 0) {
+		return 0;
+	}
 
-	return std::accumulate(m_bulges.begin(), m_bulges.end(), 0.0f,
-		[](float sum, const Bulge &bulge){ return sum + bulge.length(); });
+	return isClosed() ? count : count - 1;
 }
 
-inline float winding(const QVector2D &start, const QVector2D &end)
+Bulge::List Polyline::bulges() const
 {
-	return (end.x() - start.x()) * (end.y() + start.y());
+	Bulge::List bulges;
+	bulges.reserve(bulgeCount());
+	forEachBulge([&bulges](const Bulge &bulge){
+		bulges.push_back(bulge);
+	});
+
+	return bulges;
+}
+
+std::shared_ptr<const Polyline::ArcList> Polyline::arcs() const
+{
+	std::shared_ptr<const ArcList> arcs = std::atomic_load(&m_arcs);
+	if (!arcs) {
+		ArcList newArcs;
+		newArcs.reserve(bulgeCount());
+		forEachBulge([&newArcs](const Bulge &bulge){
+			newArcs.push_back(bulge.isArc() ? std::make_optional(bulge.toArc()) : std::nullopt);
+		});
+
+		// Concurrent callers may compute the same arcs, last one is kept.
+		arcs = std::make_shared<const ArcList>(std::move(newArcs));
+		std::atomic_store(&m_arcs, arcs);
+	}
+
+	return arcs;
 }
 
-inline float winding(const Bulge &bulge)
+double Polyline::length() const
 {
-	return winding(bulge.start(), bulge.end());
+	assert(vertexCount() > 0);
+
+	double length = 0.0;
+	forEachBulge([&length](const Bulge &bulge){
+		length += bulge.length();
+	});
+
+	return length;
+}
+
+inline double winding(const Vector2D &start, const Vector2D &end)
+{
+	return (end.x() - start.x()) * (end.y() + start.y());
 }
 
 Orientation Polyline::orientation() const
 {
-	assert(!m_bulges.empty() && isClosed());
+	assert(vertexCount() > 0 && isClosed());
 
-	const float windingSum = std::accumulate(m_bulges.begin(), m_bulges.end(), 0.0f,
-		[](float sum, const Bulge &bulge){ return sum + winding(bulge); });
+	double windingSum = 0.0;
+	for (int index = 0, count = bulgeCount(); index < count; ++index) {
+		windingSum += winding(pointAt(index), pointAt(index + 1));
+	}
 
 	return (windingSum > 0) ? Orientation::CW : Orientation::CCW;
 }
 
-Polyline &Polyline::invert()
+Rect Polyline::boundingRect() const
+{
+	std::shared_ptr<const Rect> boundingRect = std::atomic_load(&m_boundingRect);
+	if (!boundingRect) {
+		Rect rect;
+		forEachBulge([&rect](const Bulge &bulge){
+			rect |= bulge.boundingRect();
+		});
+
+		boundingRect = std::make_shared<const Rect>(rect);
+		std::atomic_store(&m_boundingRect, boundingRect);
+	}
+
+	return *boundingRect;
+}
+
+bool Polyline::contains(const Vector2D &point) const
 {
-	for (Bulge &bulge : m_bulges) {
-		bulge.invert();
+	assert(isClosed());
+
+	int count = 0;
+	forEachBulge([&count, &point](const Bulge &bulge){
+		count += bulge.crossingCount(point);
+	});
+
+	return (count % 2) == 1;
+}
+
+bool Polyline::intersects(const Rect &rect) const
+{
+	for (int index = 0, count = bulgeCount(); index < count; ++index) {
+		if (bulgeAt(index).intersects(rect)) {
+			return true;
+		}
 	}
 
-	std::reverse(m_bulges.begin(), m_bulges.end());
+	return false;
+}
+
+double Polyline::distanceToPoint(const Vector2D &point) const
+{
+	double distance = std::numeric_limits<double>::max();
+	forEachBulge([&distance, &point](const Bulge &bulge){
+		distance = std::min(distance, bulge.distanceToPoint(point));
+	});
+
+	return distance;
+}
+
+Polyline &Polyline::invert()
+{
+	// Arcs follow bulge direction, bounding rectangle is unchanged
+	m_arcs.reset();
+
+	m_reversed = !m_reversed;
 
 	return *this;
 }
@@ -144,9 +359,86 @@ Polyline Polyline::inverse() const
 	return inversed.invert();
 }
 
+Polyline &Polyline::rotateToClosestStart(const Vector2D &point)
+{
+	assert(isClosed());
+
+	if (isPoint()) {
+		return *this;
+	}
+
+	const int count = bulgeCount();
+
+	// Find closest point on all bulges
+	int closestIndex = 0;
+	double closestRatio = 0.0;
+	double closestDistance = std::numeric_limits<double>::max();
+	for (int index = 0; index < count; ++index) {
+		const Bulge bulge = bulgeAt(index);
+		const double ratio = bulge.closestPointRatio(point);
+		const double distance = bulge.pointAt(ratio).distanceToPoint(point);
+		if (distance < closestDistance) {
+			closestIndex = index;
+			closestRatio = ratio;
+			closestDistance = distance;
+		}
+	}
+
+	// Avoid creating a degenerated bulge when closest point is near a vertex
+	constexpr double vertexTolerance = 1e-5;
+	const Bulge closestBulge = bulgeAt(closestIndex);
+	const double closestLength = closestBulge.length();
+
+	// Keep vertices shared when start is already the closest point
+	if ((closestIndex == 0 && closestRatio * closestLength <= vertexTolerance) ||
+		(closestIndex == count - 1 && (1.0 - closestRatio) * closestLength <= vertexTolerance)) {
+		return *this;
+	}
+
+	VertexList &vertices = mutableVertices().vertexes();
+
+	if (closestRatio * closestLength <= vertexTolerance) {
+		std::rotate(vertices.begin(), vertices.begin() + closestIndex, vertices.end());
+	}
+	else if ((1.0 - closestRatio) * closestLength <= vertexTolerance) {
+		std::rotate(vertices.begin(), vertices.begin() + closestIndex + 1, vertices.end());
+	}
+	else {
+		const Bulge::Pair splitted = closestBulge.split(closestRatio);
+
+		// Second half starts polyline and first half ends it
+		const Vector2D &splitPoint = splitted[1].start();
+		vertices[closestIndex].bulge() = splitted[0].tangent();
+		vertices.insert(vertices.begin() + closestIndex + 1, Vertex(splitPoint.x(), splitPoint.y(), splitted[1].tangent()));
+		std::rotate(vertices.begin(), vertices.begin() + closestIndex + 1, vertices.end());
+	}
+
+	return *this;
+}
+
 Polyline& Polyline::operator+=(const Polyline &other)
 {
-	m_bulges.insert(m_bulges.end(), other.m_bulges.begin(), other.m_bulges.end());
+	if (vertexCount() == 0) {
+		// Share vertices of other polyline
+		*this = other;
+	}
+	else {
+		assert(!isClosed());
+
+		const int otherBulgeCount = other.bulgeCount();
+		VertexList &vertices = mutableVertices().vertexes();
+		vertices.reserve(vertices.size() + otherBulgeCount);
+
+		// End of this polyline is replaced by start of the other one
+		vertices.pop_back();
+		for (int index = 0; index < otherBulgeCount; ++index) {
+			vertices.push_back(other.vertexAt(index));
+		}
+		const Vector2D otherEnd = other.end();
+		vertices.emplace_back(otherEnd.x(), otherEnd.y(), 0.0);
+
+		closeIfJoined();
+	}
 
 	return *this;
 }
@@ -158,28 +450,56 @@ Polyline::List Polyline::offsetted(float margin) const
 	}
 
 	// Offset CAVC polyline
-	std::vector<cavc::Polyline<double> > offsettedCcPolylines = cavc::parallelOffset(toCavc(), (double)margin);
+	std::vector<cavc::Polyline<double> > offsettedCcPolylines = cavc::parallelOffset(*toCavc(), (double)margin);
 
-	// Convert back to polylines
-	Polyline::List offsettedPolylines(offsettedCcPolylines.size());
-	std::transform(offsettedCcPolylines.begin(), offsettedCcPolylines.end(), offsettedPolylines.begin(),
-		[](const cavc::Polyline<double> &polyline) {
-			return Polyline(polyline);
-		});
+	// Take over CAVC vertices without conversion
+	Polyline::List offsettedPolylines;
+	offsettedPolylines.reserve(offsettedCcPolylines.size());
+	for (cavc::Polyline<double> &polyline : offsettedCcPolylines) {
+		offsettedPolylines.push_back(Polyline(std::move(polyline)));
+	}
 
 	return offsettedPolylines;
 }
 
-void Polyline::transform(const QTransform &matrix)
+void Polyline::transform(const Transform &matrix)
 {
-	transformBulge([&matrix](Bulge &bulge){
-		bulge.transform(matrix);
-	});
+	VertexList &vertices = mutableVertices().vertexes();
+
+	for (Vertex &vertex : vertices) {
+		const Vector2D point = matrix.map(Vector2D(vertex.x(), vertex.y()));
+		vertex.x() = point.x();
+		vertex.y() = point.y();
+	}
+
+	// Mirroring changes arcs direction
+	if (matrix.isMirroring()) {
+		for (Vertex &vertex : vertices) {
+			vertex.bulge() = -vertex.bulge();
+		}
+	}
 }
 
 bool Polyline::operator==(const Polyline &other) const
 {
-	return m_bulges == other.m_bulges;
+	if (m_vertices == other.m_vertices && m_reversed == other.m_reversed) {
+		return true;
+	}
+
+	const int count = vertexCount();
+	if (count != other.vertexCount() || isClosed() != other.isClosed()) {
+		return false;
+	}
+
+	for (int index = 0; index < count; ++index) {
+		const Vertex vertex = vertexAt(index);
+		const Vertex otherVertex = other.vertexAt(index);
+		if (vertex.x() != otherVertex.x() || vertex.y() != otherVertex.y() || vertex.bulge() != otherVertex.bulge()) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 }
@@ -8,63 +8,151 @@
 
 #include <serializer/access.h>
 
+#include <memory>
+#include <optional>
+
 namespace geometry
 {
 
+/** @brief Connected bulges stored as vertices.
+ * Vertices are stored as a CAVC polyline, passed to CAVC without conversion. They are shared
+ * between copies and copied before modification when shared, an inverted polyline reads the
+ * same vertices backward.
+ */
 class Polyline : public common::Aggregable<Polyline>
 {
 	friend serializer::Access<Polyline>;
 	friend class Pocketer;
 
+public:
+	/// Point of a polyline and tangent of the bulge going to next vertex
+	using Vertex = cavc::PlineVertex<double>;
+	using VertexList = std::vector<Vertex>;
+
+	/// Arc of each bulge, none for lines
+	using ArcList = std::vector<std::optional<Arc>>;
+
 private:
-	Bulge::List m_bulges;
+	/** Bulge i goes from vertex i to vertex i + 1, last vertex of a closed polyline
+	 * goes back to first one. Shared between copies, never modified while shared.
+	 */
+	std::shared_ptr<cavc::Polyline<double>> m_vertices;
+	/// Vertices are read from last to first with opposite tangents
+	bool m_reversed = false;
+	/// Arcs and bounding rectangle computed on demand, reset when vertices are modified
+	mutable std::shared_ptr<const ArcList> m_arcs;
+	mutable std::shared_ptr<const Rect> m_boundingRect;
+
+	/// Vertices of an open polyline ending on its start are stored closed
+	static std::shared_ptr<cavc::Polyline<double>> makeVertices(VertexList &&vertices, bool closed);
+
+	int vertexCount() const;
+	/// Point at vertex index in reading order, vertex count index is the end of a closed polyline
+	Vector2D pointAt(int index) const;
+	/// Tangent of bulge starting at vertex index
+	double tangentAt(int index) const;
+	Vertex vertexAt(int index) const;
+	Bulge bulgeAt(int index) const;
+	/// Vertices in reading order owned by this polyline, copied if shared or reversed
+	cavc::Polyline<double> &mutableVertices();
+	/// Close an open polyline if its end joined its start
+	void closeIfJoined();
+	void invalidateCaches();
 
 	explicit Polyline(const cavc::Polyline<double> &polyline);
-	cavc::Polyline<double> toCavc() const;
-	cavc::Polyline<double> toCavc(Orientation expectedOrientation) const;
-	cavc::Polyline<double> toCavc(bool inverse) const;
+	explicit Polyline(cavc::Polyline<double> &&polyline);
+	/// CAVC polyline sharing vertices, copied only when reversed
+	std::shared_ptr<const cavc::Polyline<double>> toCavc() const;
+	std::shared_ptr<const cavc::Polyline<double>> toCavc(Orientation expectedOrientation) const;
 
 public:
 	explicit Polyline() = default;
-	explicit Polyline(Bulge::List &&bulges);
+	/// Consecutive bulges are expected to be connected, only start of each bulge and end of the last one are kept.
+	explicit Polyline(const Bulge::List &bulges);
+	/// Tangent of the last vertex of an open polyline is ignored
+	explicit Polyline(VertexList &&vertices, bool closed);
 
-	const QVector2D &start() const;
-	QVector2D &start();
-	const QVector2D &end() const;
-	QVector2D &end();
+	Vector2D start() const;
+	/// Start and end of a closed polyline are the same vertex
+	void setStart(const Vector2D &start);
+	Vector2D end() const;
+	void setEnd(const Vector2D &end);
 
 	bool isClosed() const;
 	bool isPoint() const;
 	bool isLine() const;
 
-	float length() const;
+	int bulgeCount() const;
+	Bulge::List bulges() const;
+
+	double length() const;
 
 	Orientation orientation() const;
 
+	/** Bounding rectangle including arc extremes, computed on first call and kept until
+	 * polyline is modified. Safe to call concurrently on a polyline not being modified.
+	 */
+	Rect boundingRect() const;
+	/// Test if a point is inside a closed polyline using crossing number
+	bool contains(const Vector2D &point) const;
+	/// Test if any point of the polyline is inside a rectangle
+	bool intersects(const Rect &rect) const;
+	/// Distance from a point to its closest point on polyline
+	double distanceToPoint(const Vector2D &point) const;
+
+	/// Invert direction without copying vertices
 	Polyline &invert();
 	Polyline inverse() const;
 
+	/** Change start of a closed polyline to its closest point from a point,
+	 * the bulge holding this point is split if needed. Geometry is unchanged.
+	 */
+	Polyline &rotateToClosestStart(const Vector2D &point);
+
+	/// Append a polyline starting at end of this polyline
 	Polyline& operator+=(const Polyline &other);
 
+	/** Arcs of bulges computed on first call and kept until polyline is modified.
+	 * Safe to call concurrently on a polyline not being modified.
+	 */
+	std::shared_ptr<const ArcList> arcs() const;
+
+	/// Call functor with each bulge and its arc from cache, none for lines
+	template <class Functor>
+	void forEachBulgeWithArc(Functor &&functor) const
+	{
+		const std::shared_ptr<const ArcList> arcs = this->arcs();
+		for (int index = 0, count = bulgeCount(); index < count; ++index) {
+			functor(bulgeAt(index), (*arcs)[index]);
+		}
+	}
+
+	/// Call functor with each bulge, bulges are built from adjacent vertices
 	template <class Functor>
 	void forEachBulge(Functor &&functor) const
 	{
-		for (const Bulge &bulge : m_bulges) {
-			functor(bulge);
+		for (int index = 0, count = bulgeCount(); index < count; ++index) {
+			functor(bulgeAt(index));
 		}
 	}
 
+	/** Call functor with each bulge and rebuild vertices from modified bulges,
+	 * functor must keep consecutive bulges connected.
+	 */
 	template <class Functor>
 	void transformBulge(Functor &&functor)
 	{
-		for (Bulge &bulge : m_bulges) {
+		Bulge::List bulges = this->bulges();
+		for (Bulge &bulge : bulges) {
 			functor(bulge);
 		}
+
+		*this = Polyline(bulges);
 	}
 
 	Polyline::List offsetted(float margin) const;
 
-	void transform(const QTransform &matrix);
+	void transform(const Transform &matrix);
 
 	bool operator==(const Polyline &other) const;
 };
@@ -51,10 +51,10 @@ Point2DList QuadraticSpline::convertOpenedToQuadraticBezierPoints() const
 	return bezierPoints;
 }
 
-static Bezier quadraticBezierPointToCubicBezier(const QVector2D &q0, const QVector2D &q1, const QVector2D &q2)
+static Bezier quadraticBezierPointToCubicBezier(const Vector2D &q0, const Vector2D &q1, const Vector2D &q2)
 {
-	const QVector2D c1 = q0 + 2.0f * (q1 - q0) / 3.0f;
-	const QVector2D c2 = q2 + 2.0f * (q1 - q2) / 3.0f;
+	const Vector2D c1 = q0 + 2.0f * (q1 - q0) / 3.0f;
+	const Vector2D c2 = q2 + 2.0f * (q1 - q2) / 3.0f;
 
 	return Bezier(q0, c1, c2, q2);
 }
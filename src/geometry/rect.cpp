@@ -0,0 +1,100 @@
+#include <rect.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace geometry
+{
+
+Rect::Rect()
+	:m_min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+	m_max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest())
+{
+}
+
+Rect::Rect(const Vector2D &corner1, const Vector2D &corner2)
+	:Rect()
+{
+	*this |= corner1;
+	*this |= corner2;
+}
+
+const Vector2D &Rect::min() const
+{
+	return m_min;
+}
+
+const Vector2D &Rect::max() const
+{
+	return m_max;
+}
+
+bool Rect::isValid() const
+{
+	return m_min.x() <= m_max.x() && m_min.y() <= m_max.y();
+}
+
+float Rect::width() const
+{
+	return isValid() ? m_max.x() - m_min.x() : 0.0f;
+}
+
+float Rect::height() const
+{
+	return isValid() ? m_max.y() - m_min.y() : 0.0f;
+}
+
+float Rect::area() const
+{
+	return width() * height();
+}
+
+bool Rect::contains(const Vector2D &point) const
+{
+	return m_min.x() <= point.x() && point.x() <= m_max.x() &&
+		m_min.y() <= point.y() && point.y() <= m_max.y();
+}
+
+bool Rect::contains(const Rect &other) const
+{
+	return other.isValid() && contains(other.m_min) && contains(other.m_max);
+}
+
+bool Rect::intersects(const Rect &other) const
+{
+	return m_min.x() <= other.m_max.x() && other.m_min.x() <= m_max.x() &&
+		m_min.y() <= other.m_max.y() && other.m_min.y() <= m_max.y();
+}
+
+Rect &Rect::operator|=(const Vector2D &point)
+{
+	m_min = Vector2D(std::min(m_min.x(), point.x()), std::min(m_min.y(), point.y()));
+	m_max = Vector2D(std::max(m_max.x(), point.x()), std::max(m_max.y(), point.y()));
+
+	return *this;
+}
+
+Rect &Rect::operator|=(const Rect &other)
+{
+	if (other.isValid()) {
+		*this |= other.m_min;
+		*this |= other.m_max;
+	}
+
+	return *this;
+}
+
+Rect Rect::operator|(const Rect &other) const
+{
+	Rect united(*this);
+	united |= other;
+
+	return united;
+}
+
+bool Rect::operator==(const Rect &other) const
+{
+	return m_min == other.m_min && m_max == other.m_max;
+}
+
+}
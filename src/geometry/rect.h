@@ -0,0 +1,44 @@
+#pragma once
+
+#include <common/aggregable.h>
+
+#include <geometry/vector2d.h>
+
+namespace geometry
+{
+
+/** @brief Axis aligned rectangle used to reject geometric queries early.
+ * A default constructed rectangle is empty and becomes valid once a point is added.
+ */
+class Rect : public common::Aggregable<Rect>
+{
+private:
+	Vector2D m_min;
+	Vector2D m_max;
+
+public:
+	explicit Rect();
+	explicit Rect(const Vector2D &corner1, const Vector2D &corner2);
+
+	const Vector2D &min() const;
+	const Vector2D &max() const;
+
+	bool isValid() const;
+	float width() const;
+	float height() const;
+	float area() const;
+
+	bool contains(const Vector2D &point) const;
+	bool contains(const Rect &other) const;
+	bool intersects(const Rect &other) const;
+
+	/// Extend rectangle to include a point
+	Rect &operator|=(const Vector2D &point);
+	/// Extend rectangle to include an other rectangle
+	Rect &operator|=(const Rect &other);
+	Rect operator|(const Rect &other) const;
+
+	bool operator==(const Rect &other) const;
+};
+
+}
@@ -0,0 +1,254 @@
+#include <rtree.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace geometry
+{
+
+static Vector2D rectCenter(const Rect &rect)
+{
+	return (rect.min() + rect.max()) / 2.0;
+}
+
+const Rect &RTree::entryRect(int entry, bool leaf) const
+{
+	return leaf ? m_rects[entry] : m_nodes[entry].rect;
+}
+
+void RTree::adoptChildren(int node)
+{
+	for (const int child : m_nodes[node].children) {
+		if (m_nodes[node].leaf) {
+			m_itemLeaves[child] = node;
+		}
+		else {
+			m_nodes[child].parent = node;
+		}
+	}
+}
+
+std::vector<int> RTree::pack(std::vector<int> &&entries, bool leaf)
+{
+	const auto centerLess = [this, leaf](int dimension){
+		return [this, leaf, dimension](int entry1, int entry2){
+			return rectCenter(entryRect(entry1, leaf))[dimension] < rectCenter(entryRect(entry2, leaf))[dimension];
+		};
+	};
+
+	const int size = entries.size();
+	const int nodeCount = (size + NodeCapacity - 1) / NodeCapacity;
+	const int sliceCount = std::ceil(std::sqrt(nodeCount));
+	const int sliceSize = sliceCount * NodeCapacity;
+
+	std::sort(entries.begin(), entries.end(), centerLess(0));
+
+	std::vector<int> nodes;
+	nodes.reserve(nodeCount);
+	for (int sliceStart = 0; sliceStart < size; sliceStart += sliceSize) {
+		const auto sliceBegin = entries.begin() + sliceStart;
+		const auto sliceEnd = entries.begin() + std::min(sliceStart + sliceSize, size);
+		std::sort(sliceBegin, sliceEnd, centerLess(1));
+
+		for (auto nodeBegin = sliceBegin; nodeBegin < sliceEnd; nodeBegin += std::min<int>(NodeCapacity, sliceEnd - nodeBegin)) {
+			const auto nodeEnd = nodeBegin + std::min<int>(NodeCapacity, sliceEnd - nodeBegin);
+
+			Node node{Rect(), leaf, -1, std::vector<int>(nodeBegin, nodeEnd)};
+			for (const int child : node.children) {
+				node.rect |= entryRect(child, leaf);
+			}
+
+			const int index = m_nodes.size();
+			nodes.push_back(index);
+			m_nodes.push_back(std::move(node));
+			adoptChildren(index);
+		}
+	}
+
+	return nodes;
+}
+
+int RTree::chooseLeaf(const Rect &rect) const
+{
+	int index = m_root;
+	while (!m_nodes[index].leaf) {
+		const Node &node = m_nodes[index];
+
+		// Child needing the least enlargement, the smallest on ties
+		int bestChild = -1;
+		float bestEnlargement = std::numeric_limits<float>::max();
+		float bestArea = std::numeric_limits<float>::max();
+		for (const int child : node.children) {
+			const Rect &childRect = m_nodes[child].rect;
+			const float area = childRect.area();
+			const float enlargement = (childRect | rect).area() - area;
+			if (enlargement < bestEnlargement || (enlargement == bestEnlargement && area < bestArea)) {
+				bestChild = child;
+				bestEnlargement = enlargement;
+				bestArea = area;
+			}
+		}
+
+		index = bestChild;
+	}
+
+	return index;
+}
+
+void RTree::refit(int index)
+{
+	for (; index != -1; index = m_nodes[index].parent) {
+		Node &node = m_nodes[index];
+		node.rect = Rect();
+		for (const int child : node.children) {
+			node.rect |= entryRect(child, node.leaf);
+		}
+	}
+}
+
+void RTree::split(int index)
+{
+	while (index != -1 && (int)m_nodes[index].children.size() > NodeCapacity) {
+		const bool leaf = m_nodes[index].leaf;
+		const Rect &rect = m_nodes[index].rect;
+		const int dimension = (rect.width() >= rect.height()) ? 0 : 1;
+
+		std::vector<int> &children = m_nodes[index].children;
+		std::sort(children.begin(), children.end(), [this, leaf, dimension](int entry1, int entry2){
+			return rectCenter(entryRect(entry1, leaf))[dimension] < rectCenter(entryRect(entry2, leaf))[dimension];
+		});
+
+		// Move upper half to a new sibling
+		const auto middle = children.begin() + children.size() / 2;
+		Node sibling{Rect(), leaf, m_nodes[index].parent, std::vector<int>(middle, children.end())};
+		children.erase(middle, children.end());
+
+		const int siblingIndex = m_nodes.size();
+		m_nodes.push_back(std::move(sibling));
+		adoptChildren(siblingIndex);
+
+		int parent = m_nodes[index].parent;
+		if (parent == -1) {
+			// Grow a new root
+			parent = m_nodes.size();
+			m_nodes.push_back(Node{Rect(), false, -1, {index, siblingIndex}});
+			m_nodes[index].parent = parent;
+			m_nodes[siblingIndex].parent = parent;
+			m_root = parent;
+		}
+		else {
+			m_nodes[parent].children.push_back(siblingIndex);
+		}
+
+		refit(index);
+		refit(siblingIndex);
+
+		index = parent;
+	}
+}
+
+double RTree::distance(const Rect &rect, const Vector2D &point)
+{
+	if (!rect.isValid()) {
+		return std::numeric_limits<double>::max();
+	}
+
+	const double dx = std::max({rect.min().x() - point.x(), 0.0, point.x() - rect.max().x()});
+	const double dy = std::max({rect.min().y() - point.y(), 0.0, point.y() - rect.max().y()});
+
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+RTree::RTree(const Rect::List &rects)
+	:m_rects(rects),
+	m_itemLeaves(rects.size(), -1),
+	m_size(rects.size())
+{
+	if (m_rects.empty()) {
+		return;
+	}
+
+	std::vector<int> entries(m_rects.size());
+	std::iota(entries.begin(), entries.end(), 0);
+
+	// Pack leaves then upper levels until a single root
+	std::vector<int> nodes = pack(std::move(entries), true);
+	while (nodes.size() > 1) {
+		nodes = pack(std::move(nodes), false);
+	}
+
+	m_root = nodes.front();
+}
+
+int RTree::size() const
+{
+	return m_size;
+}
+
+const Rect &RTree::rect(int index) const
+{
+	return m_rects[index];
+}
+
+Rect RTree::boundingRect() const
+{
+	return (m_root == -1) ? Rect() : m_nodes[m_root].rect;
+}
+
+void RTree::insert(int index, const Rect &rect)
+{
+	if (index >= (int)m_rects.size()) {
+		m_rects.resize(index + 1);
+		m_itemLeaves.resize(index + 1, -1);
+	}
+
+	assert(m_itemLeaves[index] == -1);
+
+	m_rects[index] = rect;
+	++m_size;
+
+	if (m_root == -1) {
+		m_root = m_nodes.size();
+		m_nodes.push_back(Node{Rect(), true, -1, {}});
+	}
+
+	const int leaf = chooseLeaf(rect);
+	m_nodes[leaf].children.push_back(index);
+	m_itemLeaves[index] = leaf;
+
+	refit(leaf);
+	split(leaf);
+}
+
+void RTree::remove(int index)
+{
+	const int leaf = m_itemLeaves[index];
+	assert(leaf != -1);
+
+	std::vector<int> &children = m_nodes[leaf].children;
+	children.erase(std::find(children.begin(), children.end(), index));
+	m_itemLeaves[index] = -1;
+	--m_size;
+
+	refit(leaf);
+}
+
+void RTree::update(int index, const Rect &rect)
+{
+	remove(index);
+	insert(index, rect);
+}
+
+std::vector<int> RTree::intersecting(const Rect &window) const
+{
+	std::vector<int> indices;
+	forEachIntersecting(window, [&indices](int index){
+		indices.push_back(index);
+	});
+
+	return indices;
+}
+
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <geometry/rect.h>
+
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace geometry
+{
+
+/** @brief Bounding volume hierarchy of rectangles answering window and nearest queries.
+ * Items are identified by an index, the index of their rectangle in the list given at construction
+ * or the one given at insertion.
+ * Tree is bulk loaded by sort tile recursive packing: rectangles are sorted into vertical
+ * slices by center x, each slice is sorted by center y and cut into full nodes, the same
+ * packing is repeated on nodes until a single root remains.
+ * Items are then inserted into the leaf needing the least enlargement, overflowing nodes
+ * are split in halves along their longest axis. Removed items leave their nodes in place.
+ */
+class RTree
+{
+public:
+	/// Maximum number of children of a node
+	static constexpr int NodeCapacity = 16;
+
+private:
+	struct Node
+	{
+		Rect rect;
+		bool leaf;
+		int parent;
+		/// Children node indices, or item indices for leaves
+		std::vector<int> children;
+	};
+
+	std::vector<Node> m_nodes;
+	Rect::List m_rects;
+	/// Leaf node of every item, -1 for absent items
+	std::vector<int> m_itemLeaves;
+	int m_root = -1;
+	int m_size = 0;
+
+	/// Pack entries of one level in nodes, return indices of created nodes
+	std::vector<int> pack(std::vector<int> &&entries, bool leaf);
+	const Rect &entryRect(int entry, bool leaf) const;
+	/// Link children of a node to it
+	void adoptChildren(int node);
+
+	int chooseLeaf(const Rect &rect) const;
+	/// Recompute rectangles from node up to root
+	void refit(int node);
+	/// Split node if overflowing, up to root
+	void split(int node);
+
+	static double distance(const Rect &rect, const Vector2D &point);
+
+public:
+	explicit RTree() = default;
+	explicit RTree(const Rect::List &rects);
+
+	/// Number of items in tree
+	int size() const;
+	const Rect &rect(int index) const;
+	/// Union of all rectangles
+	Rect boundingRect() const;
+
+	/// Insert item, index must be absent of tree
+	void insert(int index, const Rect &rect);
+	/// Remove item, index must be present in tree
+	void remove(int index);
+	/// Change rectangle of an item present in tree
+	void update(int index, const Rect &rect);
+
+	/// Call functor with the index of every rectangle intersecting window
+	template <class Functor>
+	void forEachIntersecting(const Rect &window, Functor &&functor) const
+	{
+		if (m_root == -1) {
+			return;
+		}
+
+		std::vector<int> stack = {m_root};
+		while (!stack.empty()) {
+			const Node &node = m_nodes[stack.back()];
+			stack.pop_back();
+
+			if (!node.rect.intersects(window)) {
+				continue;
+			}
+
+			for (const int child : node.children) {
+				if (!node.leaf) {
+					stack.push_back(child);
+				}
+				else if (m_rects[child].intersects(window)) {
+					functor(child);
+				}
+			}
+		}
+	}
+
+	/// Indices of rectangles intersecting window
+	std::vector<int> intersecting(const Rect &window) const;
+
+	/** Closest item from a point, visiting nodes and items by increasing rectangle distance.
+	 * @param distance Functor returning exact distance of an item from point, never less
+	 * than the distance to its rectangle. Items are ignored by returning a distance over max distance.
+	 * @param maxDistance Items further than this distance are ignored.
+	 * @return Closest item index, -1 if none.
+	 */
+	template <class Distance>
+	int nearest(const Vector2D &point, Distance &&distance, double maxDistance = std::numeric_limits<double>::max()) const
+	{
+		if (m_root == -1) {
+			return -1;
+		}
+
+		struct Entry
+		{
+			double distance;
+			int index;
+			bool item;
+
+			bool operator>(const Entry &other) const
+			{
+				return distance > other.distance;
+			}
+		};
+
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		queue.push({0.0, m_root, false});
+
+		int nearestItem = -1;
+		double nearestDistance = maxDistance;
+		while (!queue.empty() && queue.top().distance <= nearestDistance) {
+			const Entry entry = queue.top();
+			queue.pop();
+
+			if (entry.item) {
+				const double itemDistance = distance(entry.index);
+				if (itemDistance <= nearestDistance) {
+					nearestItem = entry.index;
+					nearestDistance = itemDistance;
+				}
+				continue;
+			}
+
+			const Node &node = m_nodes[entry.index];
+			for (const int child : node.children) {
+				const Rect &childRect = node.leaf ? m_rects[child] : m_nodes[child].rect;
+				const double childDistance = RTree::distance(childRect, point);
+				if (childDistance <= nearestDistance) {
+					queue.push({childDistance, child, node.leaf});
+				}
+			}
+		}
+
+		return nearestItem;
+	}
+};
+
+}
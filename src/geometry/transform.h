@@ -0,0 +1,66 @@
+#pragma once
+
+#include <geometry/vector2d.h>
+
+namespace geometry
+{
+
+/** @brief Affine 2D transformation using QTransform conventions:
+ * x' = m11 * x + m21 * y + dx
+ * y' = m12 * x + m22 * y + dy
+ */
+class Transform
+{
+private:
+	double m_m11;
+	double m_m12;
+	double m_m21;
+	double m_m22;
+	double m_dx;
+	double m_dy;
+
+public:
+	/// Identity transformation
+	constexpr Transform()
+		:Transform(1.0, 0.0, 0.0, 1.0, 0.0, 0.0)
+	{
+	}
+
+	constexpr Transform(double m11, double m12, double m21, double m22, double dx, double dy)
+		:m_m11(m11),
+		m_m12(m12),
+		m_m21(m21),
+		m_m22(m22),
+		m_dx(dx),
+		m_dy(dy)
+	{
+	}
+
+	static constexpr Transform FromScale(double sx, double sy)
+	{
+		return Transform(sx, 0.0, 0.0, sy, 0.0, 0.0);
+	}
+
+	static constexpr Transform FromTranslate(double dx, double dy)
+	{
+		return Transform(1.0, 0.0, 0.0, 1.0, dx, dy);
+	}
+
+	constexpr Vector2D map(const Vector2D &point) const
+	{
+		return Vector2D(m_m11 * point.x() + m_m21 * point.y() + m_dx, m_m12 * point.x() + m_m22 * point.y() + m_dy);
+	}
+
+	constexpr double determinant() const
+	{
+		return m_m11 * m_m22 - m_m12 * m_m21;
+	}
+
+	/// True if transformation mirrors shapes, inverting arcs direction
+	constexpr bool isMirroring() const
+	{
+		return determinant() < 0.0;
+	}
+};
+
+}
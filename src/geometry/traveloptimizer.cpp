@@ -0,0 +1,347 @@
+#include <traveloptimizer.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace geometry
+{
+
+TravelOptimizer::PointAdaptor::PointAdaptor(const Point2DList &points)
+	:m_points(points)
+{
+}
+
+size_t TravelOptimizer::PointAdaptor::kdtree_get_point_count() const
+{
+	return m_points.size();
+}
+
+double TravelOptimizer::PointAdaptor::kdtree_get_pt(const size_t idx, const size_t dim) const
+{
+	return m_points[idx][dim];
+}
+
+double TravelOptimizer::LinkSums::prefix(int position) const
+{
+	double sum = 0.0;
+	for (; position > 0; position &= position - 1) {
+		sum += m_tree[position - 1];
+	}
+
+	return sum;
+}
+
+void TravelOptimizer::LinkSums::resize(int size)
+{
+	m_links.assign(size, 0.0);
+	m_tree.assign(size, 0.0);
+}
+
+void TravelOptimizer::LinkSums::set(int position, double travel)
+{
+	const double delta = travel - m_links[position];
+	m_links[position] = travel;
+
+	for (int index = position + 1, size = m_tree.size(); index <= size; index += index & -index) {
+		m_tree[index - 1] += delta;
+	}
+}
+
+double TravelOptimizer::LinkSums::sum(int begin, int end) const
+{
+	return prefix(end) - prefix(begin);
+}
+
+double TravelOptimizer::distance(const Vector2D &from, const Vector2D &to)
+{
+	return from.distanceToPoint(to);
+}
+
+const Vector2D &TravelOptimizer::exitAt(int position) const
+{
+	return (position < 0) ? m_origin : m_items[m_order[position]].end;
+}
+
+const Vector2D &TravelOptimizer::entryAt(int position) const
+{
+	return (position >= (int)m_order.size()) ? m_origin : m_items[m_order[position]].start;
+}
+
+double TravelOptimizer::linkAt(int position) const
+{
+	return distance(exitAt(position), entryAt(position + 1));
+}
+
+void TravelOptimizer::nearestNeighbourOrder()
+{
+	constexpr size_t initialSearchCount = 16;
+
+	const int size = m_items.size();
+	std::vector<bool> visited(size, false);
+
+	// Tree of items not yet visited at last build
+	std::vector<int> treeItems;
+	Point2DList treePoints;
+	PointAdaptor adaptor(treePoints);
+	std::unique_ptr<KDTree> tree;
+	size_t visitedInTree = 0;
+
+	const auto buildTree = [&]() {
+		treeItems.clear();
+		treePoints.clear();
+		for (int index = 0; index < size; ++index) {
+			if (!visited[index]) {
+				treeItems.push_back(index);
+				treePoints.push_back(m_items[index].start);
+			}
+		}
+
+		tree.reset();
+		tree = std::make_unique<KDTree>(2, adaptor);
+		tree->buildIndex();
+		visitedInTree = 0;
+	};
+
+	buildTree();
+
+	std::vector<size_t> matchIndices;
+	std::vector<double> matchDistances;
+
+	Vector2D position = m_origin;
+	m_order.clear();
+	m_order.reserve(size);
+
+	while ((int)m_order.size() < size) {
+		size_t searchCount = std::min(initialSearchCount, treeItems.size());
+		int nearest = -1;
+
+		while (nearest == -1) {
+			const double coord[2] = {position.x(), position.y()};
+			matchIndices.resize(searchCount);
+			matchDistances.resize(searchCount);
+
+			const size_t nbMatches = tree->knnSearch(coord, searchCount, matchIndices.data(), matchDistances.data());
+			for (size_t i = 0; i < nbMatches; ++i) {
+				const int item = treeItems[matchIndices[i]];
+				if (!visited[item]) {
+					nearest = item;
+					break;
+				}
+			}
+
+			if (nearest == -1) {
+				// Rebuild tree when mostly made of visited items, otherwise widen search.
+				if (visitedInTree * 2 >= treeItems.size() || searchCount >= treeItems.size()) {
+					buildTree();
+					searchCount = std::min(initialSearchCount, treeItems.size());
+				}
+				else {
+					searchCount = std::min(searchCount * 2, treeItems.size());
+				}
+			}
+		}
+
+		visited[nearest] = true;
+		++visitedInTree;
+		m_order.push_back(nearest);
+		position = m_items[nearest].end;
+	}
+}
+
+std::vector<std::vector<int>> TravelOptimizer::nearestNeighbours(const Point2DList &queries, const Point2DList &points) const
+{
+	const size_t searchCount = std::min<size_t>(NeighbourCount + 1, points.size());
+
+	PointAdaptor adaptor(points);
+	KDTree tree(2, adaptor);
+	tree.buildIndex();
+
+	std::vector<size_t> matchIndices(searchCount);
+	std::vector<double> matchDistances(searchCount);
+
+	std::vector<std::vector<int>> neighbours(queries.size());
+	for (int index = 0, size = queries.size(); index < size; ++index) {
+		const double coord[2] = {queries[index].x(), queries[index].y()};
+		const size_t nbMatches = tree.knnSearch(coord, searchCount, matchIndices.data(), matchDistances.data());
+
+		for (size_t i = 0; i < nbMatches; ++i) {
+			// Skip item itself
+			if ((int)matchIndices[i] != index) {
+				neighbours[index].push_back(matchIndices[i]);
+			}
+		}
+	}
+
+	return neighbours;
+}
+
+void TravelOptimizer::updateLinks(int begin, int end)
+{
+	const int size = m_order.size();
+
+	for (int position = begin; position < end; ++position) {
+		m_positions[m_order[position]] = position;
+	}
+
+	// Links from previous item, including the one leaving last updated item
+	for (int position = std::max(begin, 1), linkEnd = std::min(end + 1, size); position < linkEnd; ++position) {
+		const Item &previous = m_items[m_order[position - 1]];
+		const Item &item = m_items[m_order[position]];
+
+		m_forwardLinks.set(position, distance(previous.end, item.start));
+		m_backwardLinks.set(position, distance(item.end, previous.start));
+	}
+}
+
+bool TravelOptimizer::tryTwoOpt(int position)
+{
+	const int first = position + 1;
+	const Item &item = m_items[m_order[position]];
+	const Item &firstItem = m_items[m_order[first]];
+
+	for (const int candidate : m_startNeighbours[m_order[position]]) {
+		const int last = m_positions[candidate];
+		if (last <= first) {
+			continue;
+		}
+
+		// Reversing [first, last] connects item to candidate and first item to item following last.
+		const double forwardInside = m_forwardLinks.sum(first + 1, last + 1);
+		const double backwardInside = m_backwardLinks.sum(first + 1, last + 1);
+		const double delta = distance(item.end, m_items[candidate].start) + distance(firstItem.end, entryAt(last + 1))
+			- linkAt(position) - linkAt(last) + backwardInside - forwardInside;
+
+		if (delta < -1e-6) {
+			std::reverse(m_order.begin() + first, m_order.begin() + last + 1);
+			updateLinks(first, last + 1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool TravelOptimizer::tryOrOpt(int position)
+{
+	const int size = m_order.size();
+	const Item &segmentStart = m_items[m_order[position]];
+
+	for (int length = 1; length <= MaxSegmentLength && position + length <= size; ++length) {
+		const int last = position + length - 1;
+		const Item &segmentEnd = m_items[m_order[last]];
+		const double removedGain = linkAt(position - 1) + linkAt(last) - distance(exitAt(position - 1), entryAt(last + 1));
+
+		for (const int candidate : m_endNeighbours[m_order[position]]) {
+			// Insert segment after candidate
+			const int target = m_positions[candidate];
+			if (position - 1 <= target && target <= last) {
+				continue;
+			}
+
+			const double delta = distance(m_items[candidate].end, segmentStart.start) + distance(segmentEnd.end, entryAt(target + 1))
+				- linkAt(target) - removedGain;
+
+			if (delta < -1e-6) {
+				const Order segment(m_order.begin() + position, m_order.begin() + last + 1);
+				m_order.erase(m_order.begin() + position, m_order.begin() + last + 1);
+				const int insertPosition = (target < position) ? target + 1 : target + 1 - length;
+				m_order.insert(m_order.begin() + insertPosition, segment.begin(), segment.end());
+				// Only items between removed and inserted segment moved
+				updateLinks(std::min(position, insertPosition), std::max(last, insertPosition + length - 1) + 1);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void TravelOptimizer::improve()
+{
+	const int size = m_order.size();
+	if (size < 3) {
+		return;
+	}
+
+	Point2DList starts(size);
+	Point2DList ends(size);
+	std::transform(m_items.begin(), m_items.end(), starts.begin(), [](const Item &item){ return item.start; });
+	std::transform(m_items.begin(), m_items.end(), ends.begin(), [](const Item &item){ return item.end; });
+
+	m_startNeighbours = nearestNeighbours(ends, starts);
+	m_endNeighbours = nearestNeighbours(starts, ends);
+
+	m_positions.resize(size);
+	m_forwardLinks.resize(size);
+	m_backwardLinks.resize(size);
+	updateLinks(0, size);
+
+	constexpr int deadlineCheckPeriod = 64;
+
+	for (bool improved = true; improved;) {
+		improved = false;
+		for (int position = 0; position < size; ++position) {
+			if ((position % deadlineCheckPeriod) == 0 && Clock::now() > m_deadline) {
+				return;
+			}
+
+			if (position < size - 2) {
+				improved |= tryTwoOpt(position);
+			}
+			improved |= tryOrOpt(position);
+		}
+	}
+}
+
+float TravelOptimizer::travelLength(const Order &order) const
+{
+	double length = 0.0;
+	Vector2D position = m_origin;
+	for (const int index : order) {
+		length += distance(position, m_items[index].start);
+		position = m_items[index].end;
+	}
+	length += distance(position, m_origin);
+
+	return length;
+}
+
+TravelOptimizer::TravelOptimizer(const Item::List &items, const Vector2D &origin, std::chrono::milliseconds timeBudget)
+	:m_items(items),
+	m_origin(origin),
+	m_deadline(Clock::now() + timeBudget)
+{
+	Order initialOrder(m_items.size());
+	std::iota(initialOrder.begin(), initialOrder.end(), 0);
+	m_initialTravel = travelLength(initialOrder);
+
+	if (!m_items.empty()) {
+		nearestNeighbourOrder();
+		improve();
+	}
+
+	m_optimizedTravel = travelLength(m_order);
+
+	// Never return an order worse than the original one
+	if (m_optimizedTravel > m_initialTravel) {
+		m_order = initialOrder;
+		m_optimizedTravel = m_initialTravel;
+	}
+}
+
+const TravelOptimizer::Order &TravelOptimizer::order() const
+{
+	return m_order;
+}
+
+float TravelOptimizer::initialTravel() const
+{
+	return m_initialTravel;
+}
+
+float TravelOptimizer::optimizedTravel() const
+{
+	return m_optimizedTravel;
+}
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <geometry/utils.h>
+
+#include <common/aggregable.h>
+
+#include <nanoflann.hpp>
+
+#include <chrono>
+#include <memory>
+
+namespace geometry
+{
+
+/** @brief Reorder items to minimize travel distance between the end of an item
+ * and the start of the following one.
+ * The tour starts and ends at an origin point. A nearest neighbour tour is first built
+ * and then improved by 2-opt and Or-opt moves until no improvement is found or the time
+ * budget is exhausted. Items are never inverted, only their order changes.
+ */
+class TravelOptimizer
+{
+public:
+	struct Item : common::Aggregable<Item>
+	{
+		Vector2D start;
+		Vector2D end;
+	};
+
+	/// Indices of items in travel order
+	using Order = std::vector<int>;
+
+private:
+	/// Number of neighbour items considered for each improvement move
+	static constexpr int NeighbourCount = 8;
+	/// Maximum number of consecutive items moved by Or-opt
+	static constexpr int MaxSegmentLength = 3;
+
+	class PointAdaptor
+	{
+	private:
+		const Point2DList &m_points;
+
+	public:
+		explicit PointAdaptor(const Point2DList &points);
+
+		size_t kdtree_get_point_count() const;
+		double kdtree_get_pt(const size_t idx, const size_t dim) const;
+
+		template <class BBOX>
+		bool kdtree_get_bbox([[maybe_unused]] BBOX &bb) const
+		{
+			return false;
+		}
+	};
+
+	using KDTree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<double, PointAdaptor>, PointAdaptor, 2>;
+
+	/** @brief Travels of links by position, summed over ranges in logarithmic time.
+	 * Binary indexed tree, changing a link doesn't update following sums.
+	 */
+	class LinkSums
+	{
+	private:
+		std::vector<double> m_links;
+		std::vector<double> m_tree;
+
+		/// Sum of links before position
+		double prefix(int position) const;
+
+	public:
+		void resize(int size);
+		void set(int position, double travel);
+		/// Sum of links in [begin, end)
+		double sum(int begin, int end) const;
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	const Item::List &m_items;
+	const Vector2D m_origin;
+	const Clock::time_point m_deadline;
+
+	Order m_order;
+	/// Position of each item in order
+	std::vector<int> m_positions;
+	/// Travel from previous item to item at position
+	LinkSums m_forwardLinks;
+	/// Travel from item at position to previous item, as if both were reversed
+	LinkSums m_backwardLinks;
+
+	/// Items whose start is near the end of an item
+	std::vector<std::vector<int>> m_startNeighbours;
+	/// Items whose end is near the start of an item
+	std::vector<std::vector<int>> m_endNeighbours;
+
+	float m_initialTravel;
+	float m_optimizedTravel;
+
+	static double distance(const Vector2D &from, const Vector2D &to);
+
+	const Vector2D &exitAt(int position) const;
+	const Vector2D &entryAt(int position) const;
+	/// Travel from item at position to the next item
+	double linkAt(int position) const;
+
+	void nearestNeighbourOrder();
+	std::vector<std::vector<int>> nearestNeighbours(const Point2DList &queries, const Point2DList &points) const;
+	/// Update positions of items in [begin, end) and links reaching them
+	void updateLinks(int begin, int end);
+	bool tryTwoOpt(int position);
+	bool tryOrOpt(int position);
+	void improve();
+
+	float travelLength(const Order &order) const;
+
+public:
+	explicit TravelOptimizer(const Item::List &items, const Vector2D &origin, std::chrono::milliseconds timeBudget);
+
+	const Order &order() const;
+	/// Travel length of items in their original order
+	float initialTravel() const;
+	/// Travel length of items in optimized order
+	float optimizedTravel() const;
+};
+
+}
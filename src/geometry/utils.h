@@ -8,14 +8,16 @@
 #include <optional>
 #include <unordered_map>
 #include <cassert>
+#include <limits>
 
-#include <QVector2D>
+#include <geometry/vector2d.h>
+#include <geometry/transform.h>
 
 #include <common/enum.h>
 
 namespace geometry
 {
-	using Point2DList = std::vector<QVector2D>;
+	using Point2DList = std::vector<Vector2D>;
 
 	enum class Orientation
 	{
@@ -34,63 +36,85 @@ namespace geometry
 		return static_cast<geometry::CuttingDirection>((static_cast<int>(dir1) + static_cast<int>(dir2)) % 2);
 	}
 
-	inline float CrossProduct(const QVector2D &p0, const QVector2D &p1, const QVector2D &p2)
+	inline double CrossProduct(const Vector2D &p0, const Vector2D &p1, const Vector2D &p2)
 	{
-		const QVector2D x = p1 - p0;
-		const QVector2D y = p2 - p0;
+		const Vector2D x = p1 - p0;
+		const Vector2D y = p2 - p0;
 
 		return x.x() * y.y() - y.x() * x.y();
 	}
 
-	inline std::optional<QVector2D> ForwardLineIntersection(const QVector2D &startA, const QVector2D &endA,
-			const QVector2D &startB, const QVector2D &endB)
+	inline std::optional<Vector2D> ForwardLineIntersection(const Vector2D &startA, const Vector2D &endA,
+			const Vector2D &startB, const Vector2D &endB)
 	{
-		const float a1 = CrossProduct(startA, endA, startB);
-		const float a2 = CrossProduct(startA, endA, endB);
+		const double a1 = CrossProduct(startA, endA, startB);
+		const double a2 = CrossProduct(startA, endA, endB);
 
 		// Lines are parallel
 		if (a1 == a2) {
 			return std::nullopt;
 		}
 
-		const float a3 = CrossProduct(startA, startB, endB);
+		const double a3 = CrossProduct(startA, startB, endB);
 		// Advance on first line
-		const float t = a3 / (a2 - a1);
+		const double t = a3 / (a2 - a1);
 
 		// The intersection is backward the first line.
-		if (t <= 0.0f) {
+		if (t <= 0.0) {
 			return std::nullopt;
 		}
 
 		return std::make_optional(startA + (t * (endA - startA)));
 	}
 
-	inline QVector2D TriangleIncenter(const QVector2D &t0, const QVector2D &t1, const QVector2D &t2)
+	inline Vector2D TriangleIncenter(const Vector2D &t0, const Vector2D &t1, const Vector2D &t2)
 	{
-		const float a = (t1 - t2).length();
-		const float b = (t0 - t2).length();
-		const float c = (t0 - t1).length();
+		const double a = (t1 - t2).length();
+		const double b = (t0 - t2).length();
+		const double c = (t0 - t1).length();
 
-		const float sum = a + b + c;
+		const double sum = a + b + c;
 		return (a * t0 + b * t1 + c * t2) / sum;
 	}
 
-	inline QVector2D PerpendicularLine(const QVector2D &line)
+	/// Center of the circle going through three points, none if points are aligned
+	inline std::optional<Vector2D> CircleCenter(const Vector2D &p0, const Vector2D &p1, const Vector2D &p2)
 	{
-		return QVector2D(-line.y(), line.x());
+		// Computed relatively to p0 to limit cancellation
+		const double bx = p1.x() - p0.x();
+		const double by = p1.y() - p0.y();
+		const double cx = p2.x() - p0.x();
+		const double cy = p2.y() - p0.y();
+
+		const double d = 2.0 * (bx * cy - by * cx);
+		if (std::abs(d) < std::numeric_limits<double>::epsilon() * (bx * bx + by * by + cx * cx + cy * cy)) {
+			return std::nullopt;
+		}
+
+		const double b2 = bx * bx + by * by;
+		const double c2 = cx * cx + cy * cy;
+		const double ux = (cy * b2 - by * c2) / d;
+		const double uy = (bx * c2 - cx * b2) / d;
+
+		return std::make_optional(Vector2D(p0.x() + ux, p0.y() + uy));
+	}
+
+	inline Vector2D PerpendicularLine(const Vector2D &line)
+	{
+		return Vector2D(-line.y(), line.x());
 	}
 
-	inline QVector2D ReflectLine(const QVector2D &vector, const QVector2D &normal)
+	inline Vector2D ReflectLine(const Vector2D &vector, const Vector2D &normal)
 	{
-		return vector - 2.0f * QVector2D::dotProduct(vector, normal) * normal;
+		return vector - 2.0f * Vector2D::dotProduct(vector, normal) * normal;
 	}
 
-	inline float NormalizedAngle(float angle)
+	inline double NormalizedAngle(double angle)
 	{
-		return (angle < 0.0f) ? (angle + M_PI * 2.0f) : angle;
+		return (angle < 0.0) ? (angle + M_PI * 2.0) : angle;
 	}
 
-	inline float LineAngle(const QVector2D &line)
+	inline double LineAngle(const Vector2D &line)
 	{
 		return std::atan2(line.y(), line.x());
 	}
@@ -98,11 +122,11 @@ namespace geometry
 	/** Ensure start < end assuming start and end are angle of a CCW arc.
 	 * @return new end angle, may remain unchanged
 	 */
-	inline float EnsureEndGreater(float start, float end)
+	inline double EnsureEndGreater(double start, double end)
 	{
 		if (end < start) {
 			// Add pi*2 ensuring end is greater than start.
-			end += M_PI * 2.0f;
+			end += M_PI * 2.0;
 		}
 
 		assert(start <= end);
@@ -111,7 +135,7 @@ namespace geometry
 	}
 
 	/// Return counter clockwise delta angle between start and end
-	inline float DeltaAngle(float start, float end)
+	inline double DeltaAngle(double start, double end)
 	{
 		return (EnsureEndGreater(start, end) - start);
 	}
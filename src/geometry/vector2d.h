@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cmath>
+
+namespace geometry
+{
+
+/** @brief Double precision 2D vector.
+ * Coordinates are stored contiguously so a vector fits in one SIMD register
+ * and arrays of vectors can be processed with packed instructions.
+ */
+class Vector2D
+{
+private:
+	double m_coords[2];
+
+public:
+	constexpr Vector2D()
+		:m_coords{0.0, 0.0}
+	{
+	}
+
+	constexpr Vector2D(double x, double y)
+		:m_coords{x, y}
+	{
+	}
+
+	constexpr double x() const
+	{
+		return m_coords[0];
+	}
+
+	constexpr double y() const
+	{
+		return m_coords[1];
+	}
+
+	void setX(double x)
+	{
+		m_coords[0] = x;
+	}
+
+	void setY(double y)
+	{
+		m_coords[1] = y;
+	}
+
+	constexpr double operator[](int index) const
+	{
+		return m_coords[index];
+	}
+
+	double &operator[](int index)
+	{
+		return m_coords[index];
+	}
+
+	double lengthSquared() const
+	{
+		return m_coords[0] * m_coords[0] + m_coords[1] * m_coords[1];
+	}
+
+	double length() const
+	{
+		return std::hypot(m_coords[0], m_coords[1]);
+	}
+
+	/// Unit vector of same direction, null vector stays null
+	Vector2D normalized() const
+	{
+		const double len = length();
+		return (len > 0.0) ? Vector2D(m_coords[0] / len, m_coords[1] / len) : Vector2D();
+	}
+
+	void normalize()
+	{
+		*this = normalized();
+	}
+
+	double distanceToPoint(const Vector2D &point) const
+	{
+		return std::hypot(m_coords[0] - point.m_coords[0], m_coords[1] - point.m_coords[1]);
+	}
+
+	static double dotProduct(const Vector2D &v1, const Vector2D &v2)
+	{
+		return v1.m_coords[0] * v2.m_coords[0] + v1.m_coords[1] * v2.m_coords[1];
+	}
+
+	Vector2D &operator+=(const Vector2D &other)
+	{
+		m_coords[0] += other.m_coords[0];
+		m_coords[1] += other.m_coords[1];
+		return *this;
+	}
+
+	Vector2D &operator-=(const Vector2D &other)
+	{
+		m_coords[0] -= other.m_coords[0];
+		m_coords[1] -= other.m_coords[1];
+		return *this;
+	}
+
+	Vector2D &operator*=(double factor)
+	{
+		m_coords[0] *= factor;
+		m_coords[1] *= factor;
+		return *this;
+	}
+
+	Vector2D &operator/=(double divisor)
+	{
+		m_coords[0] /= divisor;
+		m_coords[1] /= divisor;
+		return *this;
+	}
+
+	friend constexpr Vector2D operator+(const Vector2D &v1, const Vector2D &v2)
+	{
+		return Vector2D(v1.m_coords[0] + v2.m_coords[0], v1.m_coords[1] + v2.m_coords[1]);
+	}
+
+	friend constexpr Vector2D operator-(const Vector2D &v1, const Vector2D &v2)
+	{
+		return Vector2D(v1.m_coords[0] - v2.m_coords[0], v1.m_coords[1] - v2.m_coords[1]);
+	}
+
+	friend constexpr Vector2D operator-(const Vector2D &vector)
+	{
+		return Vector2D(-vector.m_coords[0], -vector.m_coords[1]);
+	}
+
+	friend constexpr Vector2D operator*(const Vector2D &vector, double factor)
+	{
+		return Vector2D(vector.m_coords[0] * factor, vector.m_coords[1] * factor);
+	}
+
+	friend constexpr Vector2D operator*(double factor, const Vector2D &vector)
+	{
+		return vector * factor;
+	}
+
+	/// Component wise product
+	friend constexpr Vector2D operator*(const Vector2D &v1, const Vector2D &v2)
+	{
+		return Vector2D(v1.m_coords[0] * v2.m_coords[0], v1.m_coords[1] * v2.m_coords[1]);
+	}
+
+	friend constexpr Vector2D operator/(const Vector2D &vector, double divisor)
+	{
+		return Vector2D(vector.m_coords[0] / divisor, vector.m_coords[1] / divisor);
+	}
+
+	friend constexpr bool operator==(const Vector2D &v1, const Vector2D &v2)
+	{
+		return v1.m_coords[0] == v2.m_coords[0] && v1.m_coords[1] == v2.m_coords[1];
+	}
+
+	friend constexpr bool operator!=(const Vector2D &v1, const Vector2D &v2)
+	{
+		return !(v1 == v2);
+	}
+};
+
+}
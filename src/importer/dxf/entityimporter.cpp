@@ -1,5 +1,10 @@
 #include <importer/dxf/entityimporter.h>
 
+#include <geometry/cubicspline.h>
+#include <geometry/quadraticspline.h>
+
+#include <stack>
+
 namespace importer::dxf
 {
 
@@ -14,4 +19,94 @@ void BaseEntityImporter::addPolyline(const geometry::Polyline& polyline)
 	m_layer.addPolyline(polyline);
 }
 
+static std::optional<geometry::Polyline> biarcToPolylineIfCloseEnough(const geometry::Biarc & biarc, const geometry::Bezier &bezier, const BaseEntityImporter::Settings &settings)
+{
+	const float approximateBiarcLength = biarc.approximateLength();
+	if (approximateBiarcLength > settings.minimumArcLength) {
+		return std::make_optional(biarc.toLinePolyline());
+	}
+	else {
+		const float error = bezier.maxError(biarc);
+		if (error < settings.splineToArcPrecision) {
+			// The approximation is close enough.
+			return std::make_optional(biarc.toPolyline());
+		}
+	}
+
+	return std::nullopt;
+}
+
+static geometry::Polyline bezierToPolyline(const geometry::Bezier &rootBezier, const BaseEntityImporter::Settings &settings)
+{
+	// Queue of bezier to convert to biarc
+	std::stack<geometry::Bezier, geometry::Bezier::List> bezierStack({rootBezier});
+
+	geometry::Polyline polyline;
+
+	while (!bezierStack.empty()) {
+		const geometry::Bezier bezier = bezierStack.top();
+		bezierStack.pop();
+
+		if (bezier.approximateLength() < settings.minimumSplineLength) {
+			polyline += bezier.toLine();
+			continue;
+		}
+		else {
+			if (const std::optional<geometry::Biarc> optBiarc = bezier.toBiarc()) {
+				if (const std::optional<geometry::Polyline> optBiarcPolyline = biarcToPolylineIfCloseEnough(*optBiarc, bezier, settings)) {
+					polyline += *optBiarcPolyline;
+					continue;
+				}
+			}
+		}
+
+		// Split bezier and schedule to conversion
+		const geometry::Bezier::Pair splitted = bezier.splitHalf();
+		bezierStack.push(splitted[1]);
+		bezierStack.push(splitted[0]);
+	}
+
+	return polyline;
+}
+
+geometry::Polyline splineToPolyline(const Layer::Spline &spline, const BaseEntityImporter::Settings &settings)
+{
+	geometry::Point2DList controlPoints(spline.controlPoints);
+
+	geometry::Bezier::List beziers;
+	switch (spline.degree) {
+		case 2:
+		{
+			geometry::QuadraticSpline quadraticSpline(std::move(controlPoints), spline.closed);
+			beziers = quadraticSpline.toBeziers();
+			break;
+		}
+		case 3:
+		{
+			geometry::CubicSpline cubicSpline(std::move(controlPoints), spline.closed);
+			beziers = cubicSpline.toBeziers();
+			break;
+		}
+		default:
+		{
+			throw std::logic_error(fmt::format("Conversion of {}d spline not implemented", spline.degree));
+			break;
+		}
+	}
+
+	geometry::Bezier::List convexBeziers;
+	for (const geometry::Bezier &bezier : beziers) {
+		geometry::Bezier::List splitted = bezier.splitToConvex();
+		convexBeziers.insert(convexBeziers.end(), splitted.begin(), splitted.end());
+	}
+
+	// Full spline polyline
+	geometry::Polyline polyline;
+	for (const geometry::Bezier &bezier : convexBeziers) {
+		polyline += bezierToPolyline(bezier, settings);
+	}
+
+	return polyline;
+}
+
 }
@@ -3,13 +3,13 @@
 #include <importer/dxf/utils.h>
 
 #include <importer/dxf/layer.h>
-#include <geometry/cubicspline.h>
-#include <geometry/quadraticspline.h>
 
 #include <libdxfrw/drw_entities.h>
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 namespace importer::dxf
 {
 
@@ -45,7 +45,7 @@ public:
 template <>
 inline void EntityImporter<DRW_Point>::operator()(const DRW_Point &point)
 {
-	const QVector2D pos(toVector2D(point.basePoint));
+	const geometry::Vector2D pos(toVector2D(point.basePoint));
 	const geometry::Bulge bulge(pos, pos, 0.0f);
 
 	addPolyline(geometry::Polyline({bulge}));
@@ -69,44 +69,28 @@ inline void EntityImporter<DRW_LWPolyline>::operator()(const DRW_LWPolyline &lwp
 
 	const bool opened = !(lwpolyline.flags & (1 << 0));
 
-	// One bulge more if openeded polyline, to connect last vertex to first vertex.
-	geometry::Bulge::List bulges(size - ((int)opened));
-
-	const std::shared_ptr<DRW_Vertex2D>& firstVertex = lwpolyline.vertlist.front();
-	std::shared_ptr<DRW_Vertex2D> vertex = firstVertex;
-	QVector2D start(vertex->x, vertex->y);
-
-	for (int i = 1; i < size; ++i) {
-		const std::shared_ptr<DRW_Vertex2D>& nextVertex = lwpolyline.vertlist[i];
-		const QVector2D end(nextVertex->x, nextVertex->y);
-
-		bulges[i - 1] = geometry::Bulge(start, end, vertex->bulge);
-
-		// Pass to next vertex begin
-		vertex = nextVertex;
-		start = end;
-	}
+	geometry::Polyline::VertexList vertices;
+	vertices.reserve(size);
 
-	// Create end to start bulge if closed polyline.
-	if (!opened) {
-		const QVector2D end(firstVertex->x, firstVertex->y);
-		bulges.back() = geometry::Bulge(start, end, 0.0f);
+	// Bulge of last vertex closes the polyline
+	for (const std::shared_ptr<DRW_Vertex2D>& vertex : lwpolyline.vertlist) {
+		vertices.emplace_back(vertex->x, vertex->y, vertex->bulge);
 	}
 
-	addPolyline(geometry::Polyline(std::move(bulges)));
+	addPolyline(geometry::Polyline(std::move(vertices), !opened));
 }
 
 template <>
 inline void EntityImporter<DRW_Circle>::operator()(const DRW_Circle &circle)
 {
-	const float radius = circle.radious;
-	const QVector2D center(toVector2D(circle.basePoint));
+	const double radius = circle.radious;
+	const geometry::Vector2D center(toVector2D(circle.basePoint));
 
-	const QVector2D startPoint(center.x() - radius, center.y());
-	const QVector2D endPoint(center.x() + radius, center.y());
+	const geometry::Vector2D startPoint(center.x() - radius, center.y());
+	const geometry::Vector2D endPoint(center.x() + radius, center.y());
 
-	const geometry::Bulge b1(startPoint, endPoint, 1.0f);
-	const geometry::Bulge b2(endPoint, startPoint, 1.0f);
+	const geometry::Bulge b1(startPoint, endPoint, 1.0);
+	const geometry::Bulge b2(endPoint, startPoint, 1.0);
 
 	addPolyline(geometry::Polyline({b1, b2}));
 }
@@ -114,33 +98,33 @@ inline void EntityImporter<DRW_Circle>::operator()(const DRW_Circle &circle)
 template <>
 inline void EntityImporter<DRW_Arc>::operator()(const DRW_Arc &arc)
 {
-	const float radius = arc.radious;
+	const double radius = arc.radious;
 
-	if (radius > 0.0f) {
-		const float startAngle = arc.staangle;
-		const float endAngle = arc.endangle;
-		const QVector2D center(toVector2D(arc.basePoint));
+	if (radius > 0.0) {
+		const double startAngle = arc.staangle;
+		const double endAngle = arc.endangle;
+		const geometry::Vector2D center(toVector2D(arc.basePoint));
 
-		const QVector2D relativeStart = QVector2D(std::cos(startAngle), std::sin(startAngle)) * radius;
-		const QVector2D relativeEnd = QVector2D(std::cos(endAngle), std::sin(endAngle)) * radius;
+		const geometry::Vector2D relativeStart = geometry::Vector2D(std::cos(startAngle), std::sin(startAngle)) * radius;
+		const geometry::Vector2D relativeEnd = geometry::Vector2D(std::cos(endAngle), std::sin(endAngle)) * radius;
 
-		const QVector2D start = relativeStart + center;
-		const QVector2D end = relativeEnd + center;
+		const geometry::Vector2D start = relativeStart + center;
+		const geometry::Vector2D end = relativeEnd + center;
 
-		const float theta = geometry::DeltaAngle(startAngle, endAngle);
+		const double theta = geometry::DeltaAngle(startAngle, endAngle);
 	    
 		// Dxf arcs are CCW
-		assert(theta > 0.0f);
+		assert(theta > 0.0);
 
 		// Split arc in two to avoid |tangent| > 1
 		if (theta > M_PI) {
-			const float newtheta = theta / 2.0f;
-			const float theta4 = newtheta / 4.0f;
-			const float tangent = std::tan(theta4);
+			const double newtheta = theta / 2.0;
+			const double theta4 = newtheta / 4.0;
+			const double tangent = std::tan(theta4);
 
-			const float middleAngle = startAngle + newtheta;
-			const QVector2D relativeMiddle = QVector2D(std::cos(middleAngle), std::sin(middleAngle)) * radius;
-			const QVector2D middle = relativeMiddle + center;
+			const double middleAngle = startAngle + newtheta;
+			const geometry::Vector2D relativeMiddle = geometry::Vector2D(std::cos(middleAngle), std::sin(middleAngle)) * radius;
+			const geometry::Vector2D middle = relativeMiddle + center;
 
 			const geometry::Bulge bulge1(start, middle, tangent);
 			const geometry::Bulge bulge2(middle, end, tangent);
@@ -148,8 +132,8 @@ inline void EntityImporter<DRW_Arc>::operator()(const DRW_Arc &arc)
 			addPolyline(geometry::Polyline({bulge1, bulge2}));
 		}
 		else {
-			const float theta4 = theta / 4.0f;
-			const float tangent = std::tan(theta4);
+			const double theta4 = theta / 4.0;
+			const double tangent = std::tan(theta4);
 
 			const geometry::Bulge bulge(start, end, tangent);
 
@@ -158,100 +142,25 @@ inline void EntityImporter<DRW_Arc>::operator()(const DRW_Arc &arc)
 	}
 }
 
-inline std::optional<geometry::Polyline> biarcToPolylineIfCloseEnough(const geometry::Biarc & biarc, const geometry::Bezier &bezier, const BaseEntityImporter::Settings &settings)
-{
-	const float approximateBiarcLength = biarc.approximateLength();
-	if (approximateBiarcLength > settings.minimumArcLength) {
-		return std::make_optional(biarc.toLinePolyline());
-	}
-	else {
-		const float error = bezier.maxError(biarc);
-		if (error < settings.splineToArcPrecision) {
-			// The approximation is close enough.
-			return std::make_optional(biarc.toPolyline());
-		}
-	}
-
-	return std::nullopt;
-}
-
-inline geometry::Polyline bezierToPolyline(const geometry::Bezier &rootBezier, const BaseEntityImporter::Settings &settings)
-{
-	// Queue of bezier to convert to biarc
-	std::stack<geometry::Bezier, geometry::Bezier::List> bezierStack({rootBezier});
-
-	geometry::Polyline polyline;
-
-	while (!bezierStack.empty()) {
-		const geometry::Bezier bezier = bezierStack.top();
-		bezierStack.pop();
-
-		if (bezier.approximateLength() < settings.minimumSplineLength) {
-			polyline += bezier.toLine();
-			continue;
-		}
-		else {
-			if (const std::optional<geometry::Biarc> optBiarc = bezier.toBiarc()) {
-				if (const std::optional<geometry::Polyline> optBiarcPolyline = biarcToPolylineIfCloseEnough(*optBiarc, bezier, settings)) {
-					polyline += *optBiarcPolyline;
-					continue;
-				}
-			}
-		}
-
-		// Split bezier and schedule to conversion
-		const geometry::Bezier::Pair splitted = bezier.splitHalf();
-		bezierStack.push(splitted[1]);
-		bezierStack.push(splitted[0]);
-	}
-
-	return polyline;
-}
-
 template <>
 inline void EntityImporter<DRW_Spline>::operator()(const DRW_Spline &spline)
 {
+	const int degree = spline.degree;
+	// Unsupported splines are reported while parsing even if conversion is deferred.
+	if (degree != 2 && degree != 3) {
+		throw std::logic_error(fmt::format("Conversion of {}d spline not implemented", degree));
+	}
+
 	const bool closed = spline.flags & (1 << 0);
 
 	geometry::Point2DList controlPoints(spline.ncontrol);
 	std::transform(spline.controllist.begin(), spline.controllist.end(),
 		controlPoints.begin(), [](const std::shared_ptr<DRW_Coord>& coord){ return toVector2D(*coord); });
 
-	geometry::Bezier::List beziers;
-	const int degree = spline.degree;
-	switch (degree) {
-		case 2:
-		{
-			geometry::QuadraticSpline spline(std::move(controlPoints), closed);
-			beziers = spline.toBeziers();
-			break;
-		}
-		case 3:
-		{
-			geometry::CubicSpline spline(std::move(controlPoints), closed);
-			beziers = spline.toBeziers();
-			break;
-		}
-		default:
-		{
-			throw std::logic_error(fmt::format("Conversion of {}d spline not implemented", degree));
-			break;
-		}
-	}
-
-	geometry::Bezier::List convexBeziers;
-	for (const geometry::Bezier &bezier : beziers) {
-		geometry::Bezier::List splitted = bezier.splitToConvex();
-		convexBeziers.insert(convexBeziers.end(), splitted.begin(), splitted.end());
-	}
-
-	// Full spline polyline
-	geometry::Polyline polyline;
-	for (const geometry::Bezier &bezier : convexBeziers) {
-		polyline += bezierToPolyline(bezier, m_settings);
-	}
-
-	addPolyline(polyline);
+	m_layer.addSpline(std::move(controlPoints), degree, closed);
 }
 
+/// Convert a captured spline to polyline made of biarcs, safe to call concurrently
+geometry::Polyline splineToPolyline(const Layer::Spline &spline, const BaseEntityImporter::Settings &settings);
+
 }
@@ -2,6 +2,7 @@
 #include <interface.h>
 
 #include <common/exception.h>
+#include <common/parallel.h>
 
 #include <libdxfrw/libdxfrw.h>
 
@@ -16,6 +17,37 @@ void Importer::addLayer(const DRW_Layer &layer)
 	}
 }
 
+void Importer::convertSplines()
+{
+	struct PendingSpline
+	{
+		const Layer::Spline *spline;
+		geometry::Polyline polyline;
+	};
+
+	std::vector<PendingSpline> pendingSplines;
+	for (const auto &[name, layer] : m_nameToLayers) {
+		for (const Layer::Spline &spline : layer.splines()) {
+			pendingSplines.push_back({&spline, geometry::Polyline()});
+		}
+	}
+
+	common::parallelFor(pendingSplines.size(), [this, &pendingSplines](size_t index){
+		PendingSpline &pendingSpline = pendingSplines[index];
+		pendingSpline.polyline = splineToPolyline(*pendingSpline.spline, m_entityImporterSettings);
+	});
+
+	// Give back polylines to layers in the same order
+	std::vector<PendingSpline>::iterator pendingIt = pendingSplines.begin();
+	for (auto &[name, layer] : m_nameToLayers) {
+		geometry::Polyline::List polylines;
+		for (size_t i = 0, size = layer.splines().size(); i < size; ++i, ++pendingIt) {
+			polylines.push_back(std::move(pendingIt->polyline));
+		}
+		layer.resolveSplines(std::move(polylines));
+	}
+}
+
 Importer::Importer(const std::string& filename, float splineToArcPrecision, float minimumSplineLength, float minimumArcLength)
 	:m_entityImporterSettings({splineToArcPrecision, minimumSplineLength, minimumArcLength}),
 	m_ignoreEntities(false)
@@ -26,6 +58,8 @@ Importer::Importer(const std::string& filename, float splineToArcPrecision, floa
 	if (!rw.read(&interface, false)) {
 		throw common::FileCouldNotOpenException();
 	}
+
+	convertSplines();
 }
 
 Layer::List Importer::layers() const
@@ -23,6 +23,8 @@ private:
 	bool m_ignoreEntities;
 
 	void addLayer(const DRW_Layer &layer);
+	/// Convert splines captured during parsing concurrently
+	void convertSplines();
 
 public:
 	explicit Importer(const std::string &filename, float splineToArcPrecision, float minimumSplineLength, float minimumArcLength);
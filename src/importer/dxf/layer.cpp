@@ -13,6 +13,28 @@ void Layer::addPolyline(const geometry::Polyline& polyline)
 	m_polylines.push_back(polyline);
 }
 
+void Layer::addSpline(geometry::Point2DList &&controlPoints, int degree, bool closed)
+{
+	m_splines.push_back({{}, std::move(controlPoints), degree, closed, (int)m_polylines.size()});
+	m_polylines.emplace_back();
+}
+
+const Layer::Spline::List &Layer::splines() const
+{
+	return m_splines;
+}
+
+void Layer::resolveSplines(geometry::Polyline::List &&polylines)
+{
+	assert(polylines.size() == m_splines.size());
+
+	for (int index = 0, size = m_splines.size(); index < size; ++index) {
+		m_polylines[m_splines[index].polylineIndex] = std::move(polylines[index]);
+	}
+
+	m_splines.clear();
+}
+
 geometry::Polyline::List &&Layer::polylines()
 {
 	return std::move(m_polylines);
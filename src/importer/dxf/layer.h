@@ -9,8 +9,20 @@ namespace importer::dxf
 
 class Layer : public common::Aggregable<Layer>
 {
+public:
+	/// Spline captured during parsing, converted to polyline afterward
+	struct Spline : common::Aggregable<Spline>
+	{
+		geometry::Point2DList controlPoints;
+		int degree;
+		bool closed;
+		/// Index of polyline replaced by spline conversion
+		int polylineIndex;
+	};
+
 private:
 	geometry::Polyline::List m_polylines;
+	Spline::List m_splines;
 	std::string m_name;
 
 public:
@@ -19,6 +31,15 @@ public:
 	explicit Layer(const std::string& name);
 
 	void addPolyline(const geometry::Polyline& polyline);
+	/// Add a spline whose polyline is reserved at current position
+	void addSpline(geometry::Point2DList &&controlPoints, int degree, bool closed);
+
+	/// Splines waiting for conversion
+	const Spline::List &splines() const;
+	/** Replace reserved polylines by converted splines
+	 * @param polylines Converted polylines in splines order
+	 */
+	void resolveSplines(geometry::Polyline::List &&polylines);
 
 	geometry::Polyline::List &&polylines();
 
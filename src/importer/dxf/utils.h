@@ -2,14 +2,14 @@
 
 #include <libdxfrw/drw_base.h>
 
-#include <QVector2D>
+#include <geometry/vector2d.h>
 
 namespace importer::dxf
 {
 
-inline QVector2D toVector2D(const DRW_Coord &coord)
+inline geometry::Vector2D toVector2D(const DRW_Coord &coord)
 {
-	return QVector2D(coord.x, coord.y);
+	return geometry::Vector2D(coord.x, coord.y);
 }
 
 }
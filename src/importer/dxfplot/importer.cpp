@@ -1,10 +1,17 @@
 #include <importer.h>
 
 #include <fstream>
+#include <iterator>
+
+#include <QFile>
 
 #include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
 #include <cereal/types/memory.hpp>
+#include <cereal/types/string.hpp>
 
+#include <serializer/chunks.h>
+#include <serializer/format.h>
 #include <serializer/task.h>
 
 #include <common/exception.h>
@@ -18,17 +25,9 @@ Importer::Importer(const config::Tools &tools, const config::Profiles &profiles)
 {
 }
 
-model::Document::UPtr Importer::operator()(const std::string &fileName) const
-{
-	std::ifstream input(fileName);
-
-	return (*this)(input);
-}
-
-model::Document::UPtr Importer::operator()(std::istream& input) const
+template <class Archive>
+model::Document::UPtr Importer::load(Archive &archive) const
 {
-	Archive archive(input);
-
 	model::Task::UPtr task = std::make_unique<model::Task>();
 	archive(cereal::make_nvp("task", *task));
 
@@ -51,4 +50,84 @@ model::Document::UPtr Importer::operator()(std::istream& input) const
 	return std::make_unique<model::Document>(std::move(task), *tool, *profile);
 }
 
+template <class RegionReader>
+model::Document::UPtr Importer::read(std::istream &input, RegionReader &&readRegion) const
+{
+	const std::istream::pos_type start = input.tellg();
+
+	std::array<char, serializer::BinaryMagic.size()> magic;
+	input.read(magic.data(), magic.size());
+
+	if (input.gcount() == (std::streamsize)magic.size() && magic == serializer::BinaryMagic) {
+		cereal::PortableBinaryInputArchive archive(input);
+
+		std::uint32_t version;
+		archive(version);
+
+		switch (version) {
+			case 1:
+			{
+				return load(archive);
+			}
+			case 2:
+			case 3:
+			{
+				// Table of contents first, base polylines are decoded lazily from following region
+				serializer::ChunkReader reader(version);
+				cereal::UserDataAdapter<serializer::ChunkReader, cereal::PortableBinaryInputArchive> chunkedArchive(reader, input);
+				model::Document::UPtr document = load(chunkedArchive);
+
+				reader.setRegion(readRegion());
+
+				return document;
+			}
+			default:
+			{
+				throw common::ImportUnsupportedFormatVersionException();
+			}
+		}
+	}
+
+	// No header, rewind to JSON content
+	input.clear();
+	input.seekg(start);
+
+	cereal::JSONInputArchive archive(input);
+	return load(archive);
+}
+
+model::Document::UPtr Importer::operator()(const std::string &fileName) const
+{
+	std::shared_ptr<QFile> file = std::make_shared<QFile>(QString::fromStdString(fileName));
+	if (!file->open(QIODevice::ReadOnly)) {
+		throw common::FileCouldNotOpenException();
+	}
+
+	const qint64 size = file->size();
+	const char *data = reinterpret_cast<const char *>(file->map(0, size));
+	if (!data) {
+		std::ifstream input(fileName, std::ios::binary);
+		return (*this)(input);
+	}
+
+	serializer::MemoryBuffer buffer(data, size);
+	std::istream input(&buffer);
+
+	// File stays mapped as long as a lazy polyline references it
+	return read(input, [&input, file, data, size](){
+		const std::size_t offset = input.tellg();
+		return serializer::GeometryRegion{file, data + offset, size - offset};
+	});
+}
+
+model::Document::UPtr Importer::operator()(std::istream& input) const
+{
+	return read(input, [&input](){
+		// Unmapped streams keep their geometry region in memory
+		std::shared_ptr<const std::string> region = std::make_shared<const std::string>(
+				std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+		return serializer::GeometryRegion{region, region->data(), region->size()};
+	});
+}
+
 }
@@ -4,23 +4,29 @@
 
 #include <model/document.h>
 
-#include <cereal/archives/json.hpp> // TODO
-
 namespace importer::dxfplot
 {
 
 class Importer
 {
 private:
-	using Archive = cereal::JSONInputArchive;
-
 	const config::Tools &m_tools;
 	const config::Profiles &m_profiles;
 
+	template <class Archive>
+	model::Document::UPtr load(Archive &archive) const;
+	/** Load document from input, geometry region of chunked binary projects
+	 * is obtained from region reader once table of contents is read.
+	 */
+	template <class RegionReader>
+	model::Document::UPtr read(std::istream &input, RegionReader &&readRegion) const;
+
 public:
 	explicit Importer(const config::Tools &tools, const config::Profiles &profiles);
 
+	/// Load project from file, geometry of binary projects is memory mapped and decoded on first access
 	model::Document::UPtr operator()(const std::string &fileName) const;
+	/// Load binary or JSON project, detected by binary magic header
 	model::Document::UPtr operator()(std::istream& input) const;
 };
 
@@ -1,4 +1,5 @@
 #include <application.h>
+#include <snapshot.h>
 #include <geometry/assembler.h>
 #include <geometry/cleaner.h>
 
@@ -9,13 +10,23 @@
 #include <exporter/dxfplot/exporter.h>
 
 #include <common/exception.h>
+#include <common/parallel.h>
+
+#include <serializer/format.h>
+
+#include <cereal/details/helpers.hpp>
 
 #include <QMimeDatabase>
 #include <QStandardPaths>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 #include <QDebug>
 
+#include <sstream>
+#include <utility>
+
 namespace model
 {
 
@@ -36,6 +47,25 @@ static std::string configFilePath()
 	return path.toStdString();
 }
 
+/** Detect project files by extension or binary magic header,
+ * binary projects are not recognized by mime database.
+ * @return true if file is a dxfplot project
+ */
+static bool isDxfplotFile(const QString &fileName, const QMimeType &mime)
+{
+	if (fileName.endsWith(Application::FileExtension::Dxfplot, Qt::CaseInsensitive) || mime.name() == "text/plain") {
+		return true;
+	}
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	const QByteArray magic = file.read(serializer::BinaryMagic.size());
+	return magic == QByteArray::fromRawData(serializer::BinaryMagic.data(), serializer::BinaryMagic.size());
+}
+
 QString Application::baseName(const QString& fileName)
 {
 	const QFileInfo fileInfo(fileName);
@@ -85,21 +115,29 @@ void Application::cutterCompensation(float scale)
 	task.cutterCompensationSelection(scaledRadius, dxf.minimumPolylineLength(), dxf.minimumArcLength());
 }
 
-Task::UPtr Application::createTaskFromDxfImporter(const importer::dxf::Importer& importer)
+Task::UPtr Application::CreateTaskFromDxfImporter(const importer::dxf::Importer& importer, const config::Import::Dxf::Snapshot &dxf, const PathSettings &settings)
 {
-	const config::Import::Dxf &dxf = m_config.root().import().dxf();
+	importer::dxf::Layer::List importerLayers = importer.layers();
+	const size_t layerCount = importerLayers.size();
 
-	Layer::ListUPtr layers;
-	for (importer::dxf::Layer &importerLayer : importer.layers()) {
+	// Layers are independent, process their polylines concurrently.
+	std::vector<geometry::Polyline::List> layersPolylines(layerCount);
+	common::parallelFor(layerCount, [&importerLayers, &layersPolylines, &dxf](size_t index){
 		// Merge polylines to create longest contours
-		geometry::Assembler assembler(importerLayer.polylines(), dxf.assembleTolerance());
-		// Remove small bulges
-		geometry::Cleaner cleaner(assembler.polylines(), dxf.minimumPolylineLength(), dxf.minimumArcLength());
+		geometry::Assembler assembler(importerLayers[index].polylines(), dxf.assembleTolerance);
+		// Remove small bulges and simplify tessellated curves
+		geometry::Cleaner cleaner(assembler.polylines(), dxf.minimumPolylineLength, dxf.minimumArcLength, dxf.fittingTolerance);
 
-		const std::string &layerName = importerLayer.name();
+		layersPolylines[index] = cleaner.polylines();
+	});
+
+	// Qt objects are created on this thread, in importer layer order.
+	Layer::ListUPtr layers;
+	for (size_t index = 0; index < layerCount; ++index) {
+		const std::string &layerName = importerLayers[index].name();
 
 		// Create paths from merged and cleaned polylines of one layer
-		Path::ListUPtr children = Path::FromPolylines(cleaner.polylines(), defaultPathSettings(), layerName);
+		Path::ListUPtr children = Path::FromPolylines(std::move(layersPolylines[index]), settings, layerName);
 
 		layers.emplace_back(std::make_unique<Layer>(layerName, std::move(children)));
 	}
@@ -114,6 +152,13 @@ Application::Application()
 	// Default select first profile
 	m_defaultProfileConfig(&m_config.root().profiles().first())
 {
+	connect(&m_autosaveTimer, &QTimer::timeout, this, &Application::autosave);
+	updateAutosaveInterval();
+}
+
+Application::~Application()
+{
+	finishSaves();
 }
 
 config::Config &Application::config()
@@ -123,10 +168,24 @@ config::Config &Application::config()
 
 void Application::setConfig(config::Config &&config)
 {
+	// Running save refers to tool and profile of current config
+	waitForSave();
+
 	m_config = std::move(config);
+	updateAutosaveInterval();
 	emit configChanged(m_config);
 }
 
+const config::Tools::Tool &Application::defaultToolConfig() const
+{
+	return *m_defaultToolConfig;
+}
+
+const config::Profiles::Profile &Application::defaultProfileConfig() const
+{
+	return *m_defaultProfileConfig;
+}
+
 bool Application::selectTool(const QString &toolName)
 {
 	const std::string name = toolName.toStdString();
@@ -210,8 +269,10 @@ bool Application::loadFile(const QString &fileName)
 			return false;
 		}
 	}
-	else if (mineName == "text/plain") {
-		loadFromDxfplot(fileName);
+	else if (isDxfplotFile(fileName, mime)) {
+		if (!loadFromDxfplot(fileName)) {
+			return false;
+		}
 	}
 	else {
 		qCritical() << "Invalid file type: " << fileName;
@@ -231,12 +292,16 @@ bool Application::loadFile(const QString &fileName)
 
 bool Application::loadFromDxf(const QString &fileName)
 {
-	const config::Import::Dxf &dxf = m_config.root().import().dxf();
+	finishSaves();
+
+	// Settings are read once to be shared by workers
+	const config::Import::Dxf::Snapshot dxf = m_config.root().import().dxf().snapshot();
 
 	try {
-		importer::dxf::Importer importer(fileName.toStdString(), dxf.splineToArcPrecision(), dxf.minimumSplineLength(), dxf.minimumArcLength());
+		importer::dxf::Importer importer(fileName.toStdString(), dxf.splineToArcPrecision, dxf.minimumSplineLength, dxf.minimumArcLength);
  
-		m_openedDocument = std::make_unique<Document>(createTaskFromDxfImporter(importer), *m_defaultToolConfig, *m_defaultProfileConfig);
+		m_openedDocument = std::make_unique<Document>(CreateTaskFromDxfImporter(importer, dxf, defaultPathSettings()), *m_defaultToolConfig, *m_defaultProfileConfig);
+		m_mappedDxfplotFileName.clear();
 	}
 	catch (const common::FileCouldNotOpenException&) {
 		qCritical() << "File not found:" << fileName;
@@ -250,14 +315,38 @@ bool Application::loadFromDxf(const QString &fileName)
 
 bool Application::loadFromDxfplot(const QString &fileName)
 {
+	finishSaves();
+
 	try {
 		importer::dxfplot::Importer importer(m_config.root().tools(), m_config.root().profiles());
  
 		m_openedDocument = importer(fileName.toStdString());
+		m_mappedDxfplotFileName = fileName;
 	}
 	catch (const common::FileCouldNotOpenException&) {
 		return false;
 	}
+	catch (const common::ImportUnsupportedFormatVersionException&) {
+		emit errorRaised("Unsupported project format version, file was saved by a newer version");
+		return false;
+	}
+	catch (const common::ImportCouldNotFindToolConfigException&) {
+		emit errorRaised("Tool of project not found in configuration");
+		return false;
+	}
+	catch (const common::ImportCouldNotFindProfileConfigException&) {
+		emit errorRaised("Profile of project not found in configuration");
+		return false;
+	}
+	catch (const common::ImportCorruptedFileException&) {
+		emit errorRaised("Invalid project file: geometry is truncated");
+		return false;
+	}
+	catch (const cereal::Exception &exception) {
+		// Truncated or corrupted project
+		emit errorRaised(QString("Invalid project file: ") + exception.what());
+		return false;
+	}
 
 	emit documentChanged(m_openedDocument.get());
 
@@ -283,14 +372,119 @@ bool Application::saveToGcode(const QString &fileName)
 
 bool Application::saveToDxfplot(const QString &fileName)
 {
-	exporter::dxfplot::Exporter exporter;
+	// Only one save writes at a time, latest request is started once running save completes
+	if (m_saving) {
+		m_pendingSaveFileName = fileName;
+		return true;
+	}
 
-	const bool saved = saveToFile(exporter, fileName);
-	if (saved) {
-		m_lastSavedDxfplotFileName = fileName;
+	// Save thread already completed
+	waitForSave();
+
+	// Mapped file can't be replaced on every platform, worker decodes paths not yet loaded
+	// to release mapping before overwriting it. Document is not replaced until worker completes.
+	std::vector<const Path *> lazyPaths;
+	if (!m_mappedDxfplotFileName.isEmpty() && QFileInfo(fileName) == QFileInfo(m_mappedDxfplotFileName)) {
+		m_openedDocument->task().forEachPath([&lazyPaths](const Path &path){
+			if (!path.basePolylineLoaded()) {
+				lazyPaths.push_back(&path);
+			}
+		});
+		m_mappedDxfplotFileName.clear();
 	}
 
-	return saved;
+	std::shared_ptr<const DocumentSnapshot> snapshot = std::make_shared<DocumentSnapshot>(*m_openedDocument);
+
+	const exporter::dxfplot::Exporter::Format format = m_config.root().project().binaryFormat() ?
+			exporter::dxfplot::Exporter::Format::Binary : exporter::dxfplot::Exporter::Format::Json;
+
+	qInfo() << "Saving to " << fileName;
+	m_lastSavedDxfplotFileName = fileName;
+	m_lastHandledFileBaseName = baseName(fileName);
+
+	m_saving = true;
+	m_saveThread = std::thread([this, snapshot = std::move(snapshot), lazyPaths = std::move(lazyPaths), fileName, format]() mutable {
+		QString error;
+		try {
+			common::parallelFor(lazyPaths.size(), [&lazyPaths](size_t index){
+				lazyPaths[index]->basePolyline();
+			});
+
+			std::ostringstream output;
+			{
+				const Document::UPtr document = snapshot->restore();
+				const exporter::dxfplot::Exporter exporter(format);
+				exporter(*document, output);
+			}
+			// Last loaders referring to mapped file
+			snapshot.reset();
+
+			// Written to a temporary file renamed over saved file once complete
+			QSaveFile file(fileName);
+			const std::string content = output.str();
+			if (!file.open(QIODevice::WriteOnly) || file.write(content.data(), content.size()) != (qint64)content.size() || !file.commit()) {
+				error = "Couldn't save " + fileName;
+			}
+		}
+		catch (const std::exception &exception) {
+			error = exception.what();
+		}
+
+		m_saving = false;
+		QMetaObject::invokeMethod(this, [this, fileName, error](){ dxfplotSaved(fileName, error); }, Qt::QueuedConnection);
+	});
+
+	return true;
+}
+
+void Application::waitForSave()
+{
+	if (m_saveThread.joinable()) {
+		m_saveThread.join();
+	}
+}
+
+void Application::finishSaves()
+{
+	waitForSave();
+
+	if (!m_pendingSaveFileName.isEmpty()) {
+		saveToDxfplot(std::exchange(m_pendingSaveFileName, QString()));
+		waitForSave();
+	}
+}
+
+void Application::dxfplotSaved(const QString &fileName, const QString &error)
+{
+	if (error.isEmpty()) {
+		emit fileSaved(fileName);
+	}
+	else {
+		emit errorRaised(error);
+	}
+
+	// Save requested while saving, unless another one already started
+	if (!m_pendingSaveFileName.isEmpty() && !m_saving) {
+		saveToDxfplot(std::exchange(m_pendingSaveFileName, QString()));
+	}
+}
+
+void Application::updateAutosaveInterval()
+{
+	const int interval = m_config.root().project().autosaveIntervalMinutes();
+	if (interval > 0) {
+		m_autosaveTimer.start(std::chrono::minutes(interval));
+	}
+	else {
+		m_autosaveTimer.stop();
+	}
+}
+
+void Application::autosave()
+{
+	if (m_openedDocument && !m_lastSavedDxfplotFileName.isEmpty() && !m_saving) {
+		saveToDxfplot(m_lastSavedDxfplotFileName);
+	}
 }
 
 void Application::leftCutterCompensation()
@@ -318,6 +512,30 @@ void Application::pocketSelection()
 	task.pocketSelection(radius, dxf.minimumPolylineLength(), dxf.minimumArcLength());
 }
 
+void Application::pocketAll()
+{
+	const config::Import::Dxf &dxf = m_config.root().import().dxf();
+	const float radius = m_openedDocument->toolConfig().general().radius();
+
+	Task &task = m_openedDocument->task();
+	const int regionCount = task.pocketAll(radius, dxf.minimumPolylineLength(), dxf.minimumArcLength());
+
+	qInfo() << "Pocketed" << regionCount << "regions";
+}
+
+void Application::optimizeStack()
+{
+	const geometry::CuttingDirection direction = m_openedDocument->profileConfig().cut().direction();
+	const float depthPerCut = m_openedDocument->toolConfig().general().depthPerCut();
+
+	Task &task = m_openedDocument->task();
+	const auto [initialTravel, optimizedTravel] = task.optimizeStack(direction, depthPerCut, StackOptimizationTimeBudget);
+
+	qInfo() << "Rapid travel reduced from" << initialTravel << "to" << optimizedTravel;
+
+	emit stackOptimized(initialTravel, optimizedTravel);
+}
+
 void Application::transformSelection(const QTransform& matrix)
 {
 	Task &task = m_openedDocument->task();
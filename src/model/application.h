@@ -5,8 +5,11 @@
 
 #include <QObject>
 #include <QDebug>
+#include <QTimer>
 
+#include <atomic>
 #include <fstream>
+#include <thread>
 
 namespace importer::dxf
 {
@@ -25,6 +28,9 @@ private:
 	/// Global configuration
 	config::Config m_config;
 
+	/// Maximum time spent improving path order
+	static constexpr std::chrono::milliseconds StackOptimizationTimeBudget{1000};
+
 	const config::Tools::Tool *m_defaultToolConfig;
 	const config::Profiles::Profile *m_defaultProfileConfig;
 
@@ -32,20 +38,33 @@ private:
 	QString m_lastHandledFileBaseName;
 	QString m_lastSavedGcodeFileName;
 	QString m_lastSavedDxfplotFileName;
+	/// Project file mapped by lazily loaded paths of opened document, if any
+	QString m_mappedDxfplotFileName;
 
 	Document::UPtr m_openedDocument;
 
+	/// Worker saving a document snapshot, joined before next save
+	std::thread m_saveThread;
+	std::atomic<bool> m_saving{false};
+	/// File of last save requested while saving, started once running save completes
+	QString m_pendingSaveFileName;
+	QTimer m_autosaveTimer;
+
 	static QString baseName(const QString& fileName);	
 	void resetLastSavedFileNames();
 
-	PathSettings defaultPathSettings() const;
-
 	const config::Tools::Tool *findTool(const std::string &name) const;
 	const config::Profiles::Profile *findProfile(const std::string &name) const;
 
 	void cutterCompensation(float scale);
 
-	Task::UPtr createTaskFromDxfImporter(const importer::dxf::Importer& importer);
+	void waitForSave();
+	/// Complete running and pending saves before opened document is replaced
+	void finishSaves();
+	void dxfplotSaved(const QString &fileName, const QString &error);
+	void updateAutosaveInterval();
+	/// Save document to its project file if any and no save is running
+	void autosave();
 
 	template <class Exporter>
 	bool saveToFile(Exporter &exporter, const QString &fileName)
@@ -69,10 +88,21 @@ public:
 	};
 
 	explicit Application();
+	~Application();
 
 	config::Config &config();
 	void setConfig(config::Config &&config);
 
+	/** Create a task by assembling and cleaning polylines of imported layers.
+	 * Doesn't depend on application state, can be called from any thread.
+	 */
+	static Task::UPtr CreateTaskFromDxfImporter(const importer::dxf::Importer& importer, const config::Import::Dxf::Snapshot &dxf, const PathSettings &settings);
+
+	/// Settings of new paths from selected profile
+	PathSettings defaultPathSettings() const;
+	const config::Tools::Tool &defaultToolConfig() const;
+	const config::Profiles::Profile &defaultProfileConfig() const;
+
 	/// Select tool used as configuration for further operations
 	bool selectTool(const QString &toolName);
 	void defaultToolFromCmd(const QString &toolName);
@@ -90,12 +120,19 @@ public:
 	bool loadFromDxfplot(const QString &fileName);
 
 	bool saveToGcode(const QString &fileName);
+	/** Save a snapshot of document in background, file is replaced once completely written.
+	 * A save requested while saving is started once running save completes, only the
+	 * latest one is kept. Completion is notified by fileSaved or errorRaised.
+	 * @return True if save is started or queued
+	 */
 	bool saveToDxfplot(const QString &fileName);
 
 	void leftCutterCompensation();
 	void rightCutterCompensation();
 	void resetCutterCompensation();
 	void pocketSelection();
+	void pocketAll();
+	void optimizeStack();
 
 	void transformSelection(const QTransform& matrix);
 
@@ -108,6 +145,7 @@ Q_SIGNALS:
 	void configChanged(config::Config &config);
 	void errorRaised(const QString& message) const;
 	void fileSaved(const QString &fileName);
+	void stackOptimized(float initialTravel, float optimizedTravel);
 };
 
 }
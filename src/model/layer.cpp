@@ -5,8 +5,10 @@ namespace model
 
 void Layer::assignSelfToChildren()
 {
-	for (Path::UPtr &child : m_children) {
-		child->setLayer(*this);
+	m_childIndices.clear();
+	for (int index = 0, size = m_children.size(); index < size; ++index) {
+		m_children[index]->setLayer(*this);
+		m_childIndices.emplace(m_children[index].get(), index);
 	}
 }
 
@@ -37,13 +39,13 @@ const Path& Layer::childrenAt(int index) const
 
 int Layer::childIndexFor(const Path& child) const
 {
-	const Path::ListUPtr::const_iterator it = std::find_if(m_children.cbegin(), m_children.cend(), [&child](const Path::UPtr &ptr){ return ptr.get() == &child; });
+	const auto it = m_childIndices.find(&child);
 
-	if (it == m_children.cend()) {
+	if (it == m_childIndices.cend()) {
 		return -1;
 	}
 
-	return std::distance(m_children.cbegin(), it);
+	return it->second;
 }
 
 }
@@ -4,6 +4,8 @@
 
 #include <serializer/access.h>
 
+#include <unordered_map>
+
 namespace model
 {
 
@@ -15,6 +17,8 @@ class Layer : public Renderable, public common::Aggregable<Layer>
 
 private:
 	Path::ListUPtr m_children;
+	/// Index of every child in children list
+	std::unordered_map<const Path *, int> m_childIndices;
 
 	void assignSelfToChildren();
 
@@ -14,6 +14,11 @@ const geometry::Polyline::List &OffsettedPath::polylines() const
 	return m_polylines;
 }
 
+OffsettedPath::Direction OffsettedPath::direction() const
+{
+	return m_direction;
+}
+
 geometry::CuttingDirection OffsettedPath::cuttingDirection() const
 {
 	static const geometry::CuttingDirection offsetDirectionToCuttingDirection[] = {
@@ -24,7 +29,7 @@ geometry::CuttingDirection OffsettedPath::cuttingDirection() const
 	return offsetDirectionToCuttingDirection[static_cast<int>(m_direction)];
 }
 
-void OffsettedPath::transform(const QTransform &matrix)
+void OffsettedPath::transform(const geometry::Transform &matrix)
 {
 	for (geometry::Polyline &polyline : m_polylines) {
 		polyline.transform(matrix);
@@ -36,9 +36,10 @@ public:
 	explicit OffsettedPath() = default;
 
 	const geometry::Polyline::List &polylines() const;
+	Direction direction() const;
 	geometry::CuttingDirection cuttingDirection() const;
 
-	void transform(const QTransform &matrix);
+	void transform(const geometry::Transform &matrix);
 
 Q_SIGNALS:
 	void polylinesTransformed();
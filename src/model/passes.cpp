@@ -0,0 +1,52 @@
+#include <passes.h>
+
+namespace model
+{
+
+Passes::Passes(const Path &path, geometry::CuttingDirection profileDirection, float depthPerCut)
+	:m_direction(path.cuttingDirection() | profileDirection),
+	m_count(0)
+{
+	const float maxDepth = path.settings().depth();
+
+	// Same iterations as gcode export
+	for (float depth = 0.0f; depth < maxDepth + depthPerCut; depth += depthPerCut) {
+		++m_count;
+	}
+}
+
+geometry::CuttingDirection Passes::direction() const
+{
+	return m_direction;
+}
+
+int Passes::count() const
+{
+	return m_count;
+}
+
+geometry::Vector2D Passes::entry(const geometry::Polyline &polyline) const
+{
+	return entry(Path::PolylineEnds::FromPolyline(polyline));
+}
+
+geometry::Vector2D Passes::entry(const Path::PolylineEnds &ends) const
+{
+	return (m_direction == geometry::CuttingDirection::BACKWARD) ? ends.end : ends.start;
+}
+
+geometry::Vector2D Passes::exit(const geometry::Polyline &polyline) const
+{
+	return exit(Path::PolylineEnds::FromPolyline(polyline));
+}
+
+geometry::Vector2D Passes::exit(const Path::PolylineEnds &ends) const
+{
+	if (ends.closed || (m_count % 2) == 0) {
+		return entry(ends);
+	}
+
+	return (m_direction == geometry::CuttingDirection::BACKWARD) ? ends.start : ends.end;
+}
+
+}
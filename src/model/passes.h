@@ -0,0 +1,32 @@
+#pragma once
+
+#include <model/path.h>
+
+namespace model
+{
+
+/** @brief Direction and number of depth passes cutting a path.
+ * Closed polylines are cut in loop, open polylines are cut back and forth starting
+ * in cutting direction, an even number of passes leaves tool where it entered.
+ */
+class Passes
+{
+private:
+	geometry::CuttingDirection m_direction;
+	int m_count;
+
+public:
+	explicit Passes(const Path &path, geometry::CuttingDirection profileDirection, float depthPerCut);
+
+	geometry::CuttingDirection direction() const;
+	int count() const;
+
+	/// Tool position when starting to cut a polyline
+	geometry::Vector2D entry(const geometry::Polyline &polyline) const;
+	geometry::Vector2D entry(const Path::PolylineEnds &ends) const;
+	/// Tool position after cutting all passes of a polyline
+	geometry::Vector2D exit(const geometry::Polyline &polyline) const;
+	geometry::Vector2D exit(const Path::PolylineEnds &ends) const;
+};
+
+}
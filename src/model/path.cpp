@@ -18,9 +18,14 @@ void Path::updateGlobalVisibility()
 	}
 }
 
+Path::PolylineEnds Path::PolylineEnds::FromPolyline(const geometry::Polyline &polyline)
+{
+	return PolylineEnds{polyline.start(), polyline.end(), polyline.isClosed()};
+}
+
 Path::Path(geometry::Polyline &&basePolyline, const std::string &name, const PathSettings &settings)
 	:Renderable(name),
-	m_basePolyline(basePolyline),
+	m_basePolyline(std::move(basePolyline)),
 	m_settings(settings),
 	m_globallyVisible(true)
 {
@@ -58,14 +63,86 @@ void Path::setLayer(Layer &layer)
 	connect(m_layer, &Layer::visibilityChanged, this, &Path::updateGlobalVisibility);
 }
 
+geometry::Polyline &Path::mutableBasePolyline()
+{
+	basePolyline();
+	return m_basePolyline;
+}
+
 const geometry::Polyline &Path::basePolyline() const
 {
+	if (!m_basePolylineLoaded.load(std::memory_order_acquire)) {
+		// Islands of concurrent pockets may be loaded from many threads
+		std::lock_guard<std::mutex> lock(m_basePolylineMutex);
+		if (!m_basePolylineLoaded.load(std::memory_order_relaxed)) {
+			m_basePolyline = m_basePolylineLoader();
+			m_basePolylineLoader = nullptr;
+			m_basePolylineLoaded.store(true, std::memory_order_release);
+		}
+	}
+
 	return m_basePolyline;
 }
 
+void Path::setBasePolylineLoader(PolylineLoader &&loader, const geometry::Rect &boundingRect, std::optional<bool> isPoint,
+	std::optional<PolylineEnds> ends)
+{
+	m_basePolylineLoader = std::move(loader);
+	m_lazyBoundingRect = boundingRect;
+	m_lazyIsPoint = isPoint;
+	m_lazyEnds = ends;
+	m_basePolylineLoaded.store(false, std::memory_order_release);
+}
+
+bool Path::basePolylineLoaded() const
+{
+	return m_basePolylineLoaded.load(std::memory_order_acquire);
+}
+
+std::optional<Path::LazyBasePolyline> Path::lazyBasePolyline() const
+{
+	if (basePolylineLoaded()) {
+		return std::nullopt;
+	}
+
+	// Base polyline may be loaded concurrently
+	std::lock_guard<std::mutex> lock(m_basePolylineMutex);
+	if (m_basePolylineLoaded.load(std::memory_order_relaxed)) {
+		return std::nullopt;
+	}
+
+	return LazyBasePolyline{m_basePolylineLoader, m_lazyBoundingRect, m_lazyIsPoint, m_lazyEnds};
+}
+
 geometry::Polyline::List Path::finalPolylines() const
 {
-	return m_offsettedPath ? m_offsettedPath->polylines() : geometry::Polyline::List{m_basePolyline};
+	return m_offsettedPath ? m_offsettedPath->polylines() : geometry::Polyline::List{basePolyline()};
+}
+
+geometry::Rect Path::basePolylineBoundingRect() const
+{
+	return basePolylineLoaded() ? m_basePolyline.boundingRect() : m_lazyBoundingRect;
+}
+
+Path::PolylineEnds Path::basePolylineEnds() const
+{
+	if (!basePolylineLoaded() && m_lazyEnds) {
+		return *m_lazyEnds;
+	}
+
+	return PolylineEnds::FromPolyline(basePolyline());
+}
+
+geometry::Rect Path::boundingRect() const
+{
+	geometry::Rect rect = basePolylineBoundingRect();
+	if (m_offsettedPath) {
+		for (const geometry::Polyline &polyline : m_offsettedPath->polylines()) {
+			rect |= polyline.boundingRect();
+		}
+	}
+
+	return rect;
 }
 
 model::OffsettedPath *Path::offsettedPath() const
@@ -75,15 +152,13 @@ model::OffsettedPath *Path::offsettedPath() const
 
 void Path::offset(float margin, float minimumPolylineLength, float minimumArcLength)
 {
-	geometry::Polyline::List offsettedPolylines = m_basePolyline.offsetted(margin);
+	geometry::Polyline::List offsettedPolylines = basePolyline().offsetted(margin);
 	geometry::Cleaner cleaner(std::move(offsettedPolylines), minimumPolylineLength, minimumArcLength);
 
 	const OffsettedPath::Direction direction = (margin > 0.0f) ?
 			OffsettedPath::Direction::LEFT : OffsettedPath::Direction::RIGHT;
 
-	m_offsettedPath = std::make_unique<OffsettedPath>(cleaner.polylines(), direction);
-
-	emit offsettedPathChanged();
+	setOffsettedPolylines({cleaner.polylines(), direction});
 }
 
 void Path::resetOffset()
@@ -94,13 +169,18 @@ void Path::resetOffset()
 }
 
 void Path::pocket(const Path::ListCPtr &islands, float scaledRadius, float minimumPolylineLength, float minimumArcLength)
+{
+	setOffsettedPolylines(pocketPolylines(islands, scaledRadius, minimumPolylineLength, minimumArcLength));
+}
+
+Path::OffsettedPolylines Path::pocketPolylines(const Path::ListCPtr &islands, float scaledRadius, float minimumPolylineLength, float minimumArcLength) const
 {
 	geometry::Polyline::ListCPtr polylineIslands(islands.size());
 	std::transform(islands.begin(), islands.end(), polylineIslands.begin(), [](const Path *path){
 		return &path->basePolyline();
 	});
 
-	geometry::Pocketer pocketer(m_basePolyline, polylineIslands, scaledRadius, minimumPolylineLength);
+	geometry::Pocketer pocketer(basePolyline(), polylineIslands, scaledRadius, minimumPolylineLength);
 	geometry::Cleaner cleaner(std::move(pocketer.polylines()), minimumPolylineLength, minimumArcLength);
 
 	// Pocket is left when polyline is CCW winded.
@@ -110,7 +190,12 @@ void Path::pocket(const Path::ListCPtr &islands, float scaledRadius, float minim
 	};
 	const OffsettedPath::Direction direction = basePolylineOrientationToPocketDirection[static_cast<int>(pocketer.borderOrientation())];
 
-	m_offsettedPath = std::make_unique<OffsettedPath>(cleaner.polylines(), direction);
+	return {cleaner.polylines(), direction};
+}
+
+void Path::setOffsettedPolylines(OffsettedPolylines &&offsettedPolylines)
+{
+	m_offsettedPath = std::make_unique<OffsettedPath>(std::move(offsettedPolylines.polylines), offsettedPolylines.direction);
 
 	emit offsettedPathChanged();
 }
@@ -118,17 +203,24 @@ void Path::pocket(const Path::ListCPtr &islands, float scaledRadius, float minim
 
 void Path::transform(const QTransform &matrix)
 {
-	m_basePolyline.transform(matrix);
-	emit basePolylineTransformed();
+	const geometry::Transform geometryMatrix(matrix.m11(), matrix.m12(), matrix.m21(), matrix.m22(), matrix.dx(), matrix.dy());
 
+	mutableBasePolyline().transform(geometryMatrix);
 	if (m_offsettedPath) {
-		m_offsettedPath->transform(matrix);
+		m_offsettedPath->transform(geometryMatrix);
 	}
+
+	// Emitted once offsetted path is transformed to report path bounding rectangle at once
+	emit basePolylineTransformed();
 }
 
 bool Path::isPoint() const
 {
-	return m_basePolyline.isPoint();
+	if (!basePolylineLoaded() && m_lazyIsPoint) {
+		return *m_lazyIsPoint;
+	}
+
+	return basePolyline().isPoint();
 }
 
 const model::PathSettings &Path::settings() const
@@ -12,6 +12,11 @@
 
 #include <QTransform>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+
 namespace model
 {
 
@@ -23,16 +28,56 @@ class Path : public Renderable, public common::Aggregable<Path>
 
 	friend serializer::Access<Path>;
 
+public:
+	/// Decode base polyline of a lazily loaded path
+	using PolylineLoader = std::function<geometry::Polyline ()>;
+
+	/// Start, end and closed state of a polyline
+	struct PolylineEnds
+	{
+		geometry::Vector2D start;
+		geometry::Vector2D end;
+		bool closed;
+
+		static PolylineEnds FromPolyline(const geometry::Polyline &polyline);
+	};
+
+	/// Base polyline not yet loaded, with what is known about it before loading
+	struct LazyBasePolyline
+	{
+		PolylineLoader loader;
+		geometry::Rect boundingRect;
+		std::optional<bool> isPoint;
+		std::optional<PolylineEnds> ends;
+	};
+
 private:
-	geometry::Polyline m_basePolyline;
+	mutable geometry::Polyline m_basePolyline;
+	/// Loader of base polyline until first access, null once loaded
+	mutable PolylineLoader m_basePolylineLoader;
+	mutable std::atomic<bool> m_basePolylineLoaded{true};
+	mutable std::mutex m_basePolylineMutex;
+	/// Bounding rectangle and point state of base polyline known before loading
+	geometry::Rect m_lazyBoundingRect;
+	std::optional<bool> m_lazyIsPoint;
+	std::optional<PolylineEnds> m_lazyEnds;
 	std::unique_ptr<model::OffsettedPath> m_offsettedPath;
 	PathSettings m_settings;
 	Layer *m_layer;
 	bool m_globallyVisible;
 
 	void updateGlobalVisibility();
+	/// Base polyline loaded for modification
+	geometry::Polyline &mutableBasePolyline();
 
 public:
+	/// Polylines and direction of an offsetted path computed apart from the path
+	struct OffsettedPolylines
+	{
+		geometry::Polyline::List polylines;
+		OffsettedPath::Direction direction;
+	};
+
 	explicit Path(geometry::Polyline &&basePolyline, const std::string &name, const PathSettings& settings);
 	explicit Path() = default;
 
@@ -42,13 +87,33 @@ public:
 	const Layer &layer() const;
 	void setLayer(Layer &layer);
 
+	/// Base polyline, decoded on first access for lazily loaded paths
 	const geometry::Polyline &basePolyline() const;
+	/** Defer loading of base polyline to its first access, bounding rectangle of
+	 * base polyline is known without loading, as well as its point state and ends if given.
+	 */
+	void setBasePolylineLoader(PolylineLoader &&loader, const geometry::Rect &boundingRect, std::optional<bool> isPoint,
+		std::optional<PolylineEnds> ends);
+	bool basePolylineLoaded() const;
+	/// Copy of base polyline loader, none if loaded. Loader can be called from any thread.
+	std::optional<LazyBasePolyline> lazyBasePolyline() const;
+	/// Bounding rectangle of base polyline, known without loading it
+	geometry::Rect basePolylineBoundingRect() const;
+	/// Ends of base polyline, loaded only if not known
+	PolylineEnds basePolylineEnds() const;
 	geometry::Polyline::List finalPolylines() const;
+	/// Bounding rectangle of base and offsetted polylines
+	geometry::Rect boundingRect() const;
 
 	model::OffsettedPath *offsettedPath() const;
 	void offset(float margin, float minimumPolylineLength, float minimumArcLength);
 	void resetOffset();
 	void pocket(const Path::ListCPtr &islands, float scaledRadius, float minimumPolylineLength, float minimumArcLength);
+	/** Compute pocket polylines without modifying path.
+	 * Safe to call concurrently, result is applied by setOffsettedPolylines.
+	 */
+	OffsettedPolylines pocketPolylines(const Path::ListCPtr &islands, float scaledRadius, float minimumPolylineLength, float minimumArcLength) const;
+	void setOffsettedPolylines(OffsettedPolylines &&offsettedPolylines);
 
 	void transform(const QTransform &matrix);
 
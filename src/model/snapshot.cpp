@@ -0,0 +1,85 @@
+#include <snapshot.h>
+
+#include <unordered_map>
+
+namespace model
+{
+
+DocumentSnapshot::DocumentSnapshot(const Document &document)
+	:m_toolConfig(&document.toolConfig()),
+	m_profileConfig(&document.profileConfig())
+{
+	const Task &task = document.task();
+
+	std::unordered_map<const Path *, int> pathIndices;
+	pathIndices.reserve(task.pathCount());
+
+	m_layers.reserve(task.layerCount());
+	for (int layerIndex = 0, layerCount = task.layerCount(); layerIndex < layerCount; ++layerIndex) {
+		const Layer &layer = task.layerAt(layerIndex);
+
+		LayerData &layerData = m_layers.emplace_back();
+		layerData.name = layer.name();
+		layerData.visible = layer.visible();
+		layerData.paths.reserve(layer.childrenCount());
+
+		for (int childIndex = 0, childCount = layer.childrenCount(); childIndex < childCount; ++childIndex) {
+			const Path &path = layer.childrenAt(childIndex);
+			pathIndices.emplace(&path, pathIndices.size());
+
+			PathData &pathData = layerData.paths.emplace_back();
+			pathData.name = path.name();
+			pathData.visible = path.visible();
+			pathData.lazyBasePolyline = path.lazyBasePolyline();
+			if (!pathData.lazyBasePolyline) {
+				pathData.basePolyline = path.basePolyline();
+			}
+			if (const OffsettedPath *offsettedPath = path.offsettedPath()) {
+				pathData.offsettedPolylines = Path::OffsettedPolylines{offsettedPath->polylines(), offsettedPath->direction()};
+			}
+			pathData.settings = path.settings();
+		}
+	}
+
+	m_stack.reserve(task.pathCount());
+	task.forEachPathInStack([this, &pathIndices](const Path &path){
+		m_stack.push_back(pathIndices.at(&path));
+	});
+}
+
+Document::UPtr DocumentSnapshot::restore() const
+{
+	Layer::ListUPtr layers;
+
+	for (const LayerData &layerData : m_layers) {
+		Path::ListUPtr children;
+		for (const PathData &pathData : layerData.paths) {
+			geometry::Polyline basePolyline = pathData.basePolyline;
+			Path::UPtr path = std::make_unique<Path>(std::move(basePolyline), pathData.name, pathData.settings);
+			path->setVisible(pathData.visible);
+
+			if (const std::optional<Path::LazyBasePolyline> &lazy = pathData.lazyBasePolyline) {
+				Path::PolylineLoader loader = lazy->loader;
+				path->setBasePolylineLoader(std::move(loader), lazy->boundingRect, lazy->isPoint, lazy->ends);
+			}
+
+			if (pathData.offsettedPolylines) {
+				Path::OffsettedPolylines offsettedPolylines = *pathData.offsettedPolylines;
+				path->setOffsettedPolylines(std::move(offsettedPolylines));
+			}
+
+			children.push_back(std::move(path));
+		}
+
+		Layer::UPtr layer = std::make_unique<Layer>(layerData.name, std::move(children));
+		layer->setVisible(layerData.visible);
+		layers.push_back(std::move(layer));
+	}
+
+	// Paths are indexed in layers order as in snapshot, stack is restored without sorting paths
+	Task::UPtr task = std::make_unique<Task>(std::move(layers), m_stack);
+
+	return std::make_unique<Document>(std::move(task), *m_toolConfig, *m_profileConfig);
+}
+
+}
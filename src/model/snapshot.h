@@ -0,0 +1,48 @@
+#pragma once
+
+#include <model/document.h>
+
+#include <optional>
+
+namespace model
+{
+
+/** @brief Copy of document geometry and settings detached from the edited document.
+ * Taken on UI thread, a detached document is then restored from it on a worker thread
+ * to be saved without blocking edition. Polylines share their vertices with the document ones,
+ * base polylines not yet loaded are copied as loaders and decoded by the restored document.
+ */
+class DocumentSnapshot : public common::Aggregable<DocumentSnapshot>
+{
+private:
+	struct PathData
+	{
+		std::string name;
+		bool visible;
+		geometry::Polyline basePolyline;
+		std::optional<Path::LazyBasePolyline> lazyBasePolyline;
+		std::optional<Path::OffsettedPolylines> offsettedPolylines;
+		PathSettings settings;
+	};
+
+	struct LayerData
+	{
+		std::string name;
+		bool visible;
+		std::vector<PathData> paths;
+	};
+
+	std::vector<LayerData> m_layers;
+	/// Stack as indices of paths in layers order
+	std::vector<int> m_stack;
+	const config::Tools::Tool *m_toolConfig;
+	const config::Profiles::Profile *m_profileConfig;
+
+public:
+	explicit DocumentSnapshot(const Document &document);
+
+	/// Create a detached document, can be called from any thread
+	Document::UPtr restore() const;
+};
+
+}
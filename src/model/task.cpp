@@ -1,33 +1,104 @@
 #include <task.h>
+#include <passes.h>
 
+#include <geometry/containmenttree.h>
+#include <geometry/traveloptimizer.h>
+
+#include <common/parallel.h>
+
+#include <algorithm>
 #include <iterator>
+#include <limits>
 
 namespace model
 {
 
 void Task::initPathsFromLayers()
 {
-	for (const Layer::UPtr &layer : m_layers) {
-		layer->forEachChild([this](Path &path){ m_paths.push_back(&path); });
+	for (int index = 0, size = m_layers.size(); index < size; ++index) {
+		Layer &layer = *m_layers[index];
+		layer.forEachChild([this](Path &path){ m_paths.push_back(&path); });
+		m_layerIndices.emplace(&layer, index);
 	}
 
 	// Register selection/deselection on all paths.
 	forEachPath([this](Path &path) {
 		connect(&path, &Path::selectedChanged, this, [this, &path](bool selected){
-			const auto &pathIt = std::find(m_selectedPaths.begin(), m_selectedPaths.end(), &path);
-			const bool exists = (pathIt != m_selectedPaths.end());
+			pathSelectionChanged(path, selected);
+		});
+	});
 
-			if (selected && !exists) {
-				m_selectedPaths.push_back(&path);
-			}
-			else if (exists) {
-				m_selectedPaths.erase(pathIt);
-			}
+	initPathTree();
+}
 
-			emit pathSelectedChanged(path, selected);
-			emit selectionChanged(m_selectedPaths.size());
-		});
+void Task::initPathTree()
+{
+	geometry::Rect::List boundingRects(m_paths.size());
+	std::transform(m_paths.begin(), m_paths.end(), boundingRects.begin(), [](const Path *path){
+		return path->boundingRect();
 	});
+
+	m_pathTree = geometry::RTree(boundingRects);
+
+	// Keep tree up to date with path geometry.
+	for (int index = 0, size = m_paths.size(); index < size; ++index) {
+		Path &path = *m_paths[index];
+		const auto updatePath = [this, index, &path](){
+			m_pathTree.update(index, path.boundingRect());
+		};
+
+		connect(&path, &Path::basePolylineTransformed, this, updatePath);
+		connect(&path, &Path::offsettedPathChanged, this, updatePath);
+	}
+}
+
+void Task::pathSelectionChanged(Path &path, bool selected)
+{
+	const auto it = m_selectedPathPositions.find(&path);
+	const bool exists = (it != m_selectedPathPositions.end());
+
+	if (selected && !exists) {
+		m_selectedPaths.push_back(&path);
+		m_selectedPathPositions.emplace(&path, std::prev(m_selectedPaths.end()));
+	}
+	else if (!selected && exists) {
+		m_selectedPaths.erase(it->second);
+		m_selectedPathPositions.erase(it);
+	}
+
+	if (m_selectionBatch) {
+		// Path was in opposite state before its first change
+		if (m_selectionBatch->initialStates.emplace(&path, !selected).second) {
+			m_selectionBatch->paths.push_back(&path);
+		}
+	}
+	else {
+		emit pathSelectedChanged(path, selected);
+		emit selectionChanged(m_selectedPaths.size());
+	}
+}
+
+void Task::endSelectionBatch(const SelectionBatch &batch)
+{
+	// Paths may change many times during batch, only notify paths ending in another state than initial one
+	Path::ListPtr selectedPaths;
+	Path::ListPtr deselectedPaths;
+	for (Path *path : batch.paths) {
+		const bool selected = path->selected();
+		if (selected != batch.initialStates.at(path)) {
+			(selected ? selectedPaths : deselectedPaths).push_back(path);
+		}
+	}
+
+	if (!deselectedPaths.empty()) {
+		emit pathsSelectedChanged(deselectedPaths, false);
+	}
+	if (!selectedPaths.empty()) {
+		emit pathsSelectedChanged(selectedPaths, true);
+	}
+	if (!selectedPaths.empty() || !deselectedPaths.empty()) {
+		emit selectionChanged(m_selectedPaths.size());
+	}
 }
 
 void Task::initStackFromSortedPaths()
@@ -61,6 +132,17 @@ void Task::initStackFromSortedPaths()
 
 	std::transform(pathLengths.begin(), pathLengths.end(),
 		m_stack.begin(), [](const PathLength &pathLength){ return pathLength.path; });
+
+	updateStackIndices();
+}
+
+void Task::updateStackIndices()
+{
+	m_stackIndices.clear();
+	m_stackIndices.reserve(m_stack.size());
+	for (int index = 0, size = m_stack.size(); index < size; ++index) {
+		m_stackIndices.emplace(m_stack[index], index);
+	}
 }
 
 Task::Task(Layer::ListUPtr &&layers)
@@ -70,6 +152,20 @@ Task::Task(Layer::ListUPtr &&layers)
 	initStackFromSortedPaths();
 }
 
+Task::Task(Layer::ListUPtr &&layers, const std::vector<int> &stackIndices)
+	:m_layers(std::move(layers))
+{
+	initPathsFromLayers();
+
+	assert(stackIndices.size() == m_paths.size());
+
+	m_stack.reserve(stackIndices.size());
+	for (int index : stackIndices) {
+		m_stack.push_back(m_paths[index]);
+	}
+	updateStackIndices();
+}
+
 int Task::pathCount() const
 {
 	return m_paths.size();
@@ -89,11 +185,11 @@ Path &Task::pathAt(int index)
 
 int Task::pathIndexFor(const Path &path) const
 {
-	const Path::ListPtr::const_iterator it = std::find(m_stack.cbegin(), m_stack.cend(), &path);
+	const auto it = m_stackIndices.find(&path);
 
-	assert(it != m_stack.cend());
+	assert(it != m_stackIndices.cend());
 
-	return std::distance(m_stack.cbegin(), it);
+	return it->second;
 }
 
 void Task::movePath(int index, MoveDirection direction)
@@ -104,7 +200,130 @@ void Task::movePath(int index, MoveDirection direction)
 
 	if (0 <= newIndex && newIndex < pathCount()) {
 		std::swap(m_stack[index], m_stack[newIndex]);
+		m_stackIndices[m_stack[index]] = index;
+		m_stackIndices[m_stack[newIndex]] = newIndex;
+	}
+}
+
+std::pair<float, float> Task::optimizeStack(geometry::CuttingDirection profileDirection, float depthPerCut, std::chrono::milliseconds timeBudget)
+{
+	Path::ListPtr cutPaths;
+	Path::ListPtr uncutPaths;
+	geometry::TravelOptimizer::Item::List items;
+
+	for (Path *path : m_stack) {
+		const OffsettedPath *offsettedPath = path->offsettedPath();
+		if (path->globallyVisible() && !(offsettedPath && offsettedPath->polylines().empty())) {
+			// Tool enters and leaves path as in gcode export, ends of lazy base polylines are known without loading
+			const Passes passes(*path, profileDirection, depthPerCut);
+			const Path::PolylineEnds first = offsettedPath ?
+					Path::PolylineEnds::FromPolyline(offsettedPath->polylines().front()) : path->basePolylineEnds();
+			const Path::PolylineEnds last = offsettedPath ?
+					Path::PolylineEnds::FromPolyline(offsettedPath->polylines().back()) : first;
+
+			cutPaths.push_back(path);
+			items.push_back({{}, passes.entry(first), passes.exit(last)});
+		}
+		else {
+			uncutPaths.push_back(path);
+		}
 	}
+
+	const geometry::TravelOptimizer optimizer(items, geometry::Vector2D(0.0f, 0.0f), timeBudget);
+
+	m_stack.clear();
+	for (const int index : optimizer.order()) {
+		m_stack.push_back(cutPaths[index]);
+	}
+	m_stack.insert(m_stack.end(), uncutPaths.begin(), uncutPaths.end());
+	updateStackIndices();
+
+	emit stackChanged();
+
+	return std::make_pair(optimizer.initialTravel(), optimizer.optimizedTravel());
+}
+
+void Task::setStack(Path::ListPtr &&stack)
+{
+	assert(stack.size() == m_paths.size());
+
+	m_stack = std::move(stack);
+	updateStackIndices();
+
+	emit stackChanged();
+}
+
+geometry::Rect Task::boundingRect() const
+{
+	return m_pathTree.boundingRect();
+}
+
+void Task::loadBasePolylines() const
+{
+	common::parallelFor(m_paths.size(), [this](size_t index){
+		m_paths[index]->basePolyline();
+	});
+}
+
+Path *Task::nearestVisiblePath(const geometry::Vector2D &point, float maxDistance) const
+{
+	const int index = m_pathTree.nearest(point, [this, &point](int index){
+		const Path &path = *m_paths[index];
+		return path.globallyVisible() ? path.basePolyline().distanceToPoint(point) : std::numeric_limits<double>::max();
+	}, maxDistance);
+
+	return (index == -1) ? nullptr : m_paths[index];
+}
+
+int Task::selectedPathCount() const
+{
+	return m_selectedPaths.size();
+}
+
+void Task::selectAll()
+{
+	batchSelectionChange([this](){
+		forEachPath([](Path &path){
+			if (path.globallyVisible()) {
+				path.setSelected(true);
+			}
+		});
+	});
+}
+
+void Task::deselectAll()
+{
+	batchSelectionChange([this](){
+		forEachSelectedPath([](Path &path){
+			path.setSelected(false);
+		});
+	});
+}
+
+void Task::invertSelection()
+{
+	batchSelectionChange([this](){
+		forEachPath([](Path &path){
+			if (path.globallyVisible()) {
+				path.toggleSelect();
+			}
+		});
+	});
+}
+
+void Task::selectArea(const geometry::Rect &window, bool addToSelection)
+{
+	batchSelectionChange([this, &window, addToSelection](){
+		if (!addToSelection) {
+			deselectAll();
+		}
+
+		forEachPathIntersecting(window, [&window](Path &path){
+			if (path.globallyVisible() && path.basePolyline().intersects(window)) {
+				path.setSelected(true);
+			}
+		});
+	});
 }
 
 void Task::resetCutterCompensationSelection()
@@ -126,10 +345,45 @@ void Task::pocketSelection(float radius, float minimumPolylineLength, float mini
 	}
 
 	Path *border = m_selectedPaths.front();
-	const Path::ListCPtr islands(m_selectedPaths.begin() + 1, m_selectedPaths.end());
+	const Path::ListCPtr islands(std::next(m_selectedPaths.begin()), m_selectedPaths.end());
 	border->pocket(islands, radius, minimumPolylineLength, minimumArcLength);
 }
 
+int Task::pocketAll(float radius, float minimumPolylineLength, float minimumArcLength)
+{
+	Path::ListPtr closedPaths;
+	geometry::Polyline::ListCPtr polylines;
+	forEachPath([&closedPaths, &polylines](Path &path){
+		const geometry::Polyline &polyline = path.basePolyline();
+		if (path.globallyVisible() && polyline.isClosed() && !polyline.isPoint()) {
+			closedPaths.push_back(&path);
+			polylines.push_back(&polyline);
+		}
+	});
+
+	const geometry::ContainmentTree tree(polylines);
+	const geometry::ContainmentTree::Region::List regions = tree.regions();
+
+	// Compute pockets concurrently, paths are only modified afterward on this thread.
+	std::vector<Path::OffsettedPolylines> pockets(regions.size());
+	common::parallelFor(regions.size(), [&closedPaths, &regions, &pockets, radius, minimumPolylineLength, minimumArcLength](size_t index){
+		const geometry::ContainmentTree::Region &region = regions[index];
+
+		Path::ListCPtr islands(region.islands.size());
+		std::transform(region.islands.begin(), region.islands.end(), islands.begin(), [&closedPaths](int island){
+			return closedPaths[island];
+		});
+
+		pockets[index] = closedPaths[region.border]->pocketPolylines(islands, radius, minimumPolylineLength, minimumArcLength);
+	});
+
+	for (int index = 0, size = regions.size(); index < size; ++index) {
+		closedPaths[regions[index].border]->setOffsettedPolylines(std::move(pockets[index]));
+	}
+
+	return regions.size();
+}
+
 void Task::transformSelection(const QTransform& matrix)
 {
 	forEachSelectedPath([&matrix](Path &path){ path.transform(matrix); });
@@ -171,27 +425,21 @@ Layer &Task::layerAt(int index)
 
 int Task::layerIndexFor(const Layer &layer) const
 {
-	const Layer::ListUPtr::const_iterator it = std::find_if(m_layers.cbegin(), m_layers.cend(),
-			[&layer](const Layer::UPtr &ptr) { return ptr.get() == &layer; });
+	const auto it = m_layerIndices.find(&layer);
 
-	assert(it != m_layers.cend());
+	assert(it != m_layerIndices.cend());
 
-	return std::distance(m_layers.cbegin(), it);
+	return it->second;
 }
 
 std::pair<int, int> Task::layerAndPathIndexFor(const Path &path) const
 {
-	for (int layerIndex = 0, size = m_layers.size(); layerIndex < size; ++layerIndex) {
-		const Layer &layer = *m_layers[layerIndex];
-		const int childIndex = layer.childIndexFor(path);
-		if (childIndex != -1) {
-			return std::make_pair(layerIndex, childIndex);
-		}
-	}
+	const Layer &layer = path.layer();
+	const int childIndex = layer.childIndexFor(path);
 
-	assert(false && "layer not found");
+	assert(childIndex != -1 && "path not found in its layer");
 
-	return std::make_pair(-1, -1);
+	return std::make_pair(layerIndexFor(layer), childIndex);
 }
 
 }
@@ -3,8 +3,14 @@
 #include <model/path.h>
 #include <model/layer.h>
 
+#include <geometry/rtree.h>
+
 #include <serializer/access.h>
 
+#include <chrono>
+#include <list>
+#include <unordered_map>
+
 namespace model
 {
 
@@ -19,10 +25,58 @@ private:
 	Layer::ListUPtr m_layers;
 
 	Path::ListPtr m_stack;
-	Path::ListPtr m_selectedPaths;
+
+	/// Index of every path in stack
+	std::unordered_map<const Path *, int> m_stackIndices;
+	/// Index of every layer in layers list
+	std::unordered_map<const Layer *, int> m_layerIndices;
+
+	/// Selected paths in selection order
+	std::list<Path *> m_selectedPaths;
+	/// Position of selected paths in selection list for constant time lookup and removal
+	std::unordered_map<const Path *, std::list<Path *>::iterator> m_selectedPathPositions;
+
+	/// Paths whose selection changed during current batch
+	struct SelectionBatch
+	{
+		/// Paths in order of their first change
+		Path::ListPtr paths;
+		/// Selection state of paths before their first change
+		std::unordered_map<const Path *, bool> initialStates;
+	};
+	/// Current selection batch, null outside of batch
+	SelectionBatch *m_selectionBatch = nullptr;
+
+	/// Set current selection batch for its lifetime, even if batch functor throws
+	class SelectionBatchGuard
+	{
+	private:
+		SelectionBatch *&m_current;
+
+	public:
+		explicit SelectionBatchGuard(SelectionBatch *&current, SelectionBatch &batch)
+			:m_current(current)
+		{
+			m_current = &batch;
+		}
+
+		~SelectionBatchGuard()
+		{
+			m_current = nullptr;
+		}
+	};
+
+	/// Tree of paths bounding rectangles, items are indices in m_paths
+	geometry::RTree m_pathTree;
 
 	void initPathsFromLayers();
+	void initPathTree();
+
+	void pathSelectionChanged(Path &path, bool selected);
+	void endSelectionBatch(const SelectionBatch &batch);
+
 	void initStackFromSortedPaths();
+	void updateStackIndices();
 
 public:
 	enum class MoveDirection
@@ -33,6 +87,8 @@ public:
 
 	explicit Task() = default;
 	explicit Task(Layer::ListUPtr &&layers);
+	/// Task with a known stack containing every path of layers once, paths are not sorted
+	explicit Task(Layer::ListUPtr &&layers, const std::vector<int> &stackIndices);
 
 	int pathCount() const;
 	const Path &pathAt(int index) const;
@@ -40,6 +96,15 @@ public:
 	int pathIndexFor(const Path &path) const;
 
 	void movePath(int index, MoveDirection direction);
+	/** Reorder stack to minimize rapid travel between paths starting and ending at origin.
+	 * Paths not producing any cut are moved to the stack end.
+	 * @param profileDirection Cutting direction of profile, with depth per cut gives path entry and exit points.
+	 * @param timeBudget Maximum time spent improving order.
+	 * @return Travel length before and after reordering.
+	 */
+	std::pair<float, float> optimizeStack(geometry::CuttingDirection profileDirection, float depthPerCut, std::chrono::milliseconds timeBudget);
+	/// Replace stack order, stack must contain every path once
+	void setStack(Path::ListPtr &&stack);
 
 	template <class Functor>
 	void forEachPathInStack(Functor &&functor) const
@@ -68,15 +133,81 @@ public:
 	template <class Functor>
 	void forEachSelectedPath(Functor &&functor) const
 	{
-		const Path::ListPtr selectedPaths(m_selectedPaths);
+		// Functor may change selection
+		const Path::ListPtr selectedPaths(m_selectedPaths.begin(), m_selectedPaths.end());
 		for (Path *path : selectedPaths) {
 			functor(*path);
 		}
 	}
 
+	int selectedPathCount() const;
+
+	/** Call functor changing selection of many paths, selection changes are notified once
+	 * at end by pathsSelectedChanged and selectionChanged. Only paths whose final state differs
+	 * from their state before batch are notified. Nested batches are merged in outermost one.
+	 */
+	template <class Functor>
+	void batchSelectionChange(Functor &&functor)
+	{
+		if (m_selectionBatch) {
+			functor();
+			return;
+		}
+
+		SelectionBatch batch;
+		{
+			const SelectionBatchGuard guard(m_selectionBatch, batch);
+			functor();
+		}
+
+		endSelectionBatch(batch);
+	}
+
+	/// Select all globally visible paths
+	void selectAll();
+	void deselectAll();
+	/// Toggle selection of all globally visible paths
+	void invertSelection();
+	/// Select globally visible paths having any point inside window
+	void selectArea(const geometry::Rect &window, bool addToSelection);
+
+	/// Bounding rectangle of all paths including offsetted polylines
+	geometry::Rect boundingRect() const;
+	/// Decode base polylines of all lazily loaded paths
+	void loadBasePolylines() const;
+
+	/// Call functor with every path whose bounding rectangle intersects window
+	template <class Functor>
+	void forEachPathIntersecting(const geometry::Rect &window, Functor &&functor)
+	{
+		m_pathTree.forEachIntersecting(window, [this, &functor](int index){
+			functor(*m_paths[index]);
+		});
+	}
+
+	template <class Functor>
+	void forEachPathIntersecting(const geometry::Rect &window, Functor &&functor) const
+	{
+		m_pathTree.forEachIntersecting(window, [this, &functor](int index){
+			functor(static_cast<const Path &>(*m_paths[index]));
+		});
+	}
+
+	/** Closest globally visible path from a point
+	 * @param maxDistance Maximum distance from point to path base polyline.
+	 * @return nullptr if no path is closer than max distance.
+	 */
+	Path *nearestVisiblePath(const geometry::Vector2D &point, float maxDistance) const;
+
 	void resetCutterCompensationSelection();
 	void cutterCompensationSelection(float scaledRadius, float minimumPolylineLength, float minimumArcLength);
 	void pocketSelection(float radius, float minimumPolylineLength, float minimumArcLength);
+	/** Pocket every region of visible closed paths.
+	 * Regions are derived from paths containment: paths contained by an even number of paths
+	 * are borders and paths directly inside them are islands. Regions are computed concurrently.
+	 * @return Number of pocketed regions.
+	 */
+	int pocketAll(float radius, float minimumPolylineLength, float minimumArcLength);
 	void transformSelection(const QTransform& matrix);
 	void hideSelection();
 	void showHidden();
@@ -88,7 +219,10 @@ public:
 	std::pair<int, int> layerAndPathIndexFor(const Path &path) const;
 
 Q_SIGNALS:
+	void stackChanged();
 	void pathSelectedChanged(Path &path, bool selected);
+	/// Selection change of many paths at once, emitted at end of a batch
+	void pathsSelectedChanged(const Path::ListPtr &paths, bool selected);
 	void selectionChanged(int size);
 };
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <serializer/access.h>
-#include <serializer/qvector2d.h>
+#include <serializer/vector2d.h>
 
 #include <cereal/cereal.hpp>
 
@@ -14,13 +14,31 @@ template<>
 struct Access<geometry::Bulge>
 {
 	template <class Archive>
-	void serialize(Archive &archive, geometry::Bulge &bulge, [[maybe_unused]] std::uint32_t const version) const
+	void save(Archive &archive, const geometry::Bulge &bulge, [[maybe_unused]] std::uint32_t const version) const
 	{
 		archive(cereal::make_nvp("start", bulge.start()));
 		archive(cereal::make_nvp("end", bulge.end()));
 		archive(cereal::make_nvp("tangent", bulge.tangent()));
 	}
+
+	template <class Archive>
+	void load(Archive &archive, geometry::Bulge &bulge, std::uint32_t const version) const
+	{
+		archive(cereal::make_nvp("start", bulge.start()));
+		archive(cereal::make_nvp("end", bulge.end()));
+
+		// Tangent was saved as float before version 1
+		if (version == 0) {
+			float tangent;
+			archive(cereal::make_nvp("tangent", tangent));
+			bulge.tangent() = tangent;
+		}
+		else {
+			archive(cereal::make_nvp("tangent", bulge.tangent()));
+		}
+	}
 };
 
 }
 
+CEREAL_CLASS_VERSION(geometry::Bulge, 1);
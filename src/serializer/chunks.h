@@ -0,0 +1,197 @@
+#pragma once
+
+#include <serializer/access.h>
+#include <serializer/format.h>
+#include <serializer/polyline.h>
+
+#include <cereal/cereal.hpp>
+#include <cereal/archives/adapters.hpp>
+#include <cereal/archives/portable_binary.hpp>
+
+#include <common/exception.h>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <type_traits>
+
+namespace serializer
+{
+
+/** @brief Read only stream buffer over memory, e.g a memory mapped file.
+ * Seeking is supported to report positions of read data.
+ */
+class MemoryBuffer : public std::streambuf
+{
+public:
+	explicit MemoryBuffer(const char *data, std::size_t size)
+	{
+		char *begin = const_cast<char *>(data);
+		setg(begin, begin, begin + size);
+	}
+
+protected:
+	pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+	{
+		if (!(which & std::ios_base::in)) {
+			return pos_type(off_type(-1));
+		}
+
+		char *base = (direction == std::ios_base::beg) ? eback() : (direction == std::ios_base::cur) ? gptr() : egptr();
+		char *position = base + offset;
+		if (position < eback() || position > egptr()) {
+			return pos_type(off_type(-1));
+		}
+
+		setg(eback(), position, egptr());
+		return pos_type(position - eback());
+	}
+
+	pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+	{
+		return seekoff(off_type(position), std::ios_base::beg, which);
+	}
+};
+
+/// Location of an encoded polyline in geometry region of a binary project
+struct Chunk
+{
+	std::uint64_t offset;
+	std::uint64_t size;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(cereal::make_nvp("offset", offset));
+		archive(cereal::make_nvp("size", size));
+	}
+};
+
+/// Memory holding encoded polylines, kept alive by owner
+struct GeometryRegion
+{
+	std::shared_ptr<const void> owner;
+	const char *data = nullptr;
+	std::size_t size = 0;
+};
+
+/** @brief User data of binary archives writing base polylines of paths apart
+ * from table of contents, in a geometry region following it.
+ */
+class ChunkWriter
+{
+private:
+	std::ostringstream m_region;
+	/// Binary format version, polylines are bulge archives before version 3
+	std::uint32_t m_version;
+
+public:
+	explicit ChunkWriter(std::uint32_t version = BinaryVersion)
+		:m_version(version)
+	{
+	}
+
+	Chunk write(const geometry::Polyline &polyline)
+	{
+		const std::uint64_t offset = m_region.tellp();
+		if (m_version >= 3) {
+			Access<geometry::Polyline>().saveVertices(m_region, polyline);
+		}
+		else {
+			cereal::PortableBinaryOutputArchive archive(m_region);
+			archive(polyline);
+		}
+
+		return Chunk{offset, std::uint64_t(m_region.tellp()) - offset};
+	}
+
+	/// Encoded polylines to write after table of contents
+	std::string region() const
+	{
+		return m_region.str();
+	}
+};
+
+/** @brief User data of binary archives reading base polylines of paths lazily.
+ * Region is assigned once table of contents is read, polylines are decoded from it on first access.
+ */
+class ChunkReader
+{
+private:
+	std::shared_ptr<GeometryRegion> m_region = std::make_shared<GeometryRegion>();
+	/// Region size needed by all chunks of table of contents
+	std::uint64_t m_requiredSize = 0;
+	/// Binary format version, polylines are bulge archives before version 3
+	std::uint32_t m_version;
+
+public:
+	explicit ChunkReader(std::uint32_t version)
+		:m_version(version)
+	{
+	}
+
+	/// Assign region read after table of contents, throw if a chunk lies outside of it
+	void setRegion(GeometryRegion &&region)
+	{
+		if (region.size < m_requiredSize) {
+			throw common::ImportCorruptedFileException();
+		}
+
+		*m_region = std::move(region);
+	}
+
+	/// Functor decoding polyline of a chunk, keeping region alive
+	auto loader(const Chunk &chunk)
+	{
+		const std::uint64_t end = chunk.offset + chunk.size;
+		if (end < chunk.offset) {
+			throw common::ImportCorruptedFileException();
+		}
+		m_requiredSize = std::max(m_requiredSize, end);
+
+		return [region = m_region, chunk, version = m_version](){
+			const char *data = region->data + chunk.offset;
+			if (version >= 3) {
+				return Access<geometry::Polyline>().loadVertices(data, chunk.size);
+			}
+
+			MemoryBuffer buffer(data, chunk.size);
+			std::istream input(&buffer);
+			cereal::PortableBinaryInputArchive archive(input);
+
+			geometry::Polyline polyline;
+			archive(polyline);
+
+			return polyline;
+		};
+	}
+};
+
+/// Chunk writer of archive if saving a chunked binary project
+template <class Archive>
+ChunkWriter *chunkWriter(Archive &archive)
+{
+	if constexpr (std::is_same_v<Archive, cereal::PortableBinaryOutputArchive>) {
+		auto *adapter = dynamic_cast<cereal::UserDataAdapter<ChunkWriter, Archive> *>(&archive);
+		return adapter ? &adapter->userdata : nullptr;
+	}
+	else {
+		return nullptr;
+	}
+}
+
+/// Chunk reader of archive if loading a chunked binary project
+template <class Archive>
+ChunkReader *chunkReader(Archive &archive)
+{
+	if constexpr (std::is_same_v<Archive, cereal::PortableBinaryInputArchive>) {
+		auto *adapter = dynamic_cast<cereal::UserDataAdapter<ChunkReader, Archive> *>(&archive);
+		return adapter ? &adapter->userdata : nullptr;
+	}
+	else {
+		return nullptr;
+	}
+}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cereal/archives/portable_binary.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+namespace serializer
+{
+
+/// Magic header starting binary project files, JSON project files have no header
+constexpr std::array<char, 8> BinaryMagic = {'D', 'X', 'F', 'P', 'L', 'O', 'T', 'B'};
+/** Version of binary project files layout, written after magic header.
+ * 1: whole document in a single archive.
+ * 2: table of contents archive with paths referencing base polylines in a following geometry region.
+ * 3: same layout as 2, base polylines encoded as raw vertices instead of bulge archives.
+ */
+constexpr std::uint32_t BinaryVersion = 3;
+
+/// Write value in little endian byte order, as portable binary archives do
+template <class T>
+void writeLittleEndian(std::ostream &output, T value)
+{
+	std::array<char, sizeof(T)> bytes;
+	std::memcpy(bytes.data(), &value, sizeof(T));
+	if (!cereal::portable_binary_detail::is_little_endian()) {
+		cereal::portable_binary_detail::swap_bytes<sizeof(T)>(reinterpret_cast<std::uint8_t *>(bytes.data()));
+	}
+
+	output.write(bytes.data(), sizeof(T));
+}
+
+/// Read value written by writeLittleEndian, data must hold at least sizeof(T) bytes
+template <class T>
+T readLittleEndian(const char *data)
+{
+	std::array<char, sizeof(T)> bytes;
+	std::memcpy(bytes.data(), data, sizeof(T));
+	if (!cereal::portable_binary_detail::is_little_endian()) {
+		cereal::portable_binary_detail::swap_bytes<sizeof(T)>(reinterpret_cast<std::uint8_t *>(bytes.data()));
+	}
+
+	T value;
+	std::memcpy(&value, bytes.data(), sizeof(T));
+	return value;
+}
+
+}
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <serializer/access.h>
+#include <serializer/chunks.h>
 #include <serializer/offsettedpath.h>
 #include <serializer/pathsettings.h>
+#include <serializer/rect.h>
 #include <serializer/renderable.h>
+#include <serializer/vector2d.h>
 
 #include <cereal/cereal.hpp>
 
 #include <model/path.h>
 
+#include <optional>
+
 namespace serializer
 {
 
@@ -16,10 +21,63 @@ template<>
 struct Access<model::Path>
 {
 	template <class Archive>
-	void serialize(Archive &archive, model::Path &path, [[maybe_unused]] std::uint32_t const version) const
+	void save(Archive &archive, const model::Path &path, [[maybe_unused]] std::uint32_t const version) const
+	{
+		archive(cereal::make_nvp("renderable", cereal::base_class<model::Renderable>(&path)));
+
+		// Chunked projects store base polyline in geometry region, referenced with its bounding rectangle
+		if (ChunkWriter *writer = chunkWriter(archive)) {
+			const geometry::Polyline &basePolyline = path.basePolyline();
+			archive(cereal::make_nvp("base_polyline_chunk", writer->write(basePolyline)));
+			archive(cereal::make_nvp("base_polyline_bounding_rect", basePolyline.boundingRect()));
+			archive(cereal::make_nvp("base_polyline_is_point", basePolyline.isPoint()));
+			archive(cereal::make_nvp("base_polyline_start", basePolyline.start()));
+			archive(cereal::make_nvp("base_polyline_end", basePolyline.end()));
+			archive(cereal::make_nvp("base_polyline_is_closed", basePolyline.isClosed()));
+		}
+		else {
+			archive(cereal::make_nvp("base_polyline", path.basePolyline()));
+		}
+
+		archive(cereal::make_nvp("offsetted_path", path.m_offsettedPath));
+		archive(cereal::make_nvp("settings", path.m_settings));
+	}
+
+	template <class Archive>
+	void load(Archive &archive, model::Path &path, std::uint32_t const version) const
 	{
 		archive(cereal::make_nvp("renderable", cereal::base_class<model::Renderable>(&path)));
-		archive(cereal::make_nvp("base_polyline", path.m_basePolyline));
+
+		if (ChunkReader *reader = chunkReader(archive)) {
+			Chunk chunk;
+			archive(cereal::make_nvp("base_polyline_chunk", chunk));
+			geometry::Rect boundingRect;
+			archive(cereal::make_nvp("base_polyline_bounding_rect", boundingRect));
+
+			// Point flag is stored since version 1, older paths are decoded to know it
+			std::optional<bool> isPoint;
+			if (version >= 1) {
+				bool storedIsPoint;
+				archive(cereal::make_nvp("base_polyline_is_point", storedIsPoint));
+				isPoint = storedIsPoint;
+			}
+
+			// Ends are stored since version 2
+			std::optional<model::Path::PolylineEnds> ends;
+			if (version >= 2) {
+				model::Path::PolylineEnds storedEnds;
+				archive(cereal::make_nvp("base_polyline_start", storedEnds.start));
+				archive(cereal::make_nvp("base_polyline_end", storedEnds.end));
+				archive(cereal::make_nvp("base_polyline_is_closed", storedEnds.closed));
+				ends = storedEnds;
+			}
+
+			path.setBasePolylineLoader(reader->loader(chunk), boundingRect, isPoint, ends);
+		}
+		else {
+			archive(cereal::make_nvp("base_polyline", path.m_basePolyline));
+		}
+
 		archive(cereal::make_nvp("offsetted_path", path.m_offsettedPath));
 		archive(cereal::make_nvp("settings", path.m_settings));
 	}
@@ -27,3 +85,5 @@ struct Access<model::Path>
 
 }
 
+CEREAL_CLASS_VERSION(model::Path, 2);
+
@@ -2,21 +2,79 @@
 
 #include <serializer/access.h>
 #include <serializer/bulge.h>
+#include <serializer/format.h>
 
 #include <cereal/cereal.hpp>
 
 #include <geometry/polyline.h>
 
+#include <common/exception.h>
+
 namespace serializer
 {
 
 template<>
 struct Access<geometry::Polyline>
 {
+	// Stored as bulges to keep files compatible with vertex storage
+	template <class Archive>
+	void save(Archive &archive, const geometry::Polyline &polyline, [[maybe_unused]] std::uint32_t const version) const
+	{
+		archive(cereal::make_nvp("bulges", polyline.bulges()));
+	}
+
 	template <class Archive>
-	void serialize(Archive &archive, geometry::Polyline &polyline, [[maybe_unused]] std::uint32_t const version) const
+	void load(Archive &archive, geometry::Polyline &polyline, [[maybe_unused]] std::uint32_t const version) const
 	{
-		archive(cereal::make_nvp("bulges", polyline.m_bulges));
+		geometry::Bulge::List bulges;
+		archive(cereal::make_nvp("bulges", bulges));
+
+		polyline = geometry::Polyline(bulges);
+	}
+
+	/// Size of vertex count and closed flag
+	static constexpr std::size_t VerticesHeaderSize = sizeof(std::uint32_t) + sizeof(std::uint8_t);
+	/// Size of x, y and tangent of a vertex
+	static constexpr std::size_t VertexSize = 3 * sizeof(double);
+
+	/** Compact encoding of base polylines in binary projects: vertex count, closed flag
+	 * then x, y and tangent of each vertex in reading order, in little endian.
+	 */
+	void saveVertices(std::ostream &output, const geometry::Polyline &polyline) const
+	{
+		const int count = polyline.vertexCount();
+		writeLittleEndian<std::uint32_t>(output, count);
+		writeLittleEndian<std::uint8_t>(output, polyline.isClosed());
+
+		for (int index = 0; index < count; ++index) {
+			const geometry::Polyline::Vertex vertex = polyline.vertexAt(index);
+			writeLittleEndian(output, vertex.x());
+			writeLittleEndian(output, vertex.y());
+			writeLittleEndian(output, vertex.bulge());
+		}
+	}
+
+	/// Decode vertices written by saveVertices, throw if size doesn't match vertex count
+	geometry::Polyline loadVertices(const char *data, std::size_t size) const
+	{
+		if (size < VerticesHeaderSize) {
+			throw common::ImportCorruptedFileException();
+		}
+
+		const std::uint32_t count = readLittleEndian<std::uint32_t>(data);
+		const bool closed = readLittleEndian<std::uint8_t>(data + sizeof(std::uint32_t));
+		if (count == 0 || size != VerticesHeaderSize + count * VertexSize) {
+			throw common::ImportCorruptedFileException();
+		}
+
+		geometry::Polyline::VertexList vertices;
+		vertices.reserve(count);
+		for (const char *vertex = data + VerticesHeaderSize, *end = data + size; vertex != end; vertex += VertexSize) {
+			vertices.emplace_back(readLittleEndian<double>(vertex), readLittleEndian<double>(vertex + sizeof(double)),
+				readLittleEndian<double>(vertex + 2 * sizeof(double)));
+		}
+
+		return geometry::Polyline(std::move(vertices), closed);
 	}
 };
 
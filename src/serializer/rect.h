@@ -0,0 +1,47 @@
+#pragma once
+
+#include <serializer/access.h>
+#include <serializer/vector2d.h>
+
+#include <cereal/cereal.hpp>
+
+#include <geometry/rect.h>
+
+namespace serializer
+{
+
+template<>
+struct Access<geometry::Rect>
+{
+	template <class Archive>
+	void save(Archive &archive, const geometry::Rect &rect, [[maybe_unused]] std::uint32_t const version) const
+	{
+		// Empty rectangles have no meaningful corners
+		const bool valid = rect.isValid();
+		archive(cereal::make_nvp("valid", valid));
+		if (valid) {
+			archive(cereal::make_nvp("min", rect.min()));
+			archive(cereal::make_nvp("max", rect.max()));
+		}
+	}
+
+	template <class Archive>
+	void load(Archive &archive, geometry::Rect &rect, [[maybe_unused]] std::uint32_t const version) const
+	{
+		bool valid;
+		archive(cereal::make_nvp("valid", valid));
+		if (valid) {
+			geometry::Vector2D min;
+			archive(cereal::make_nvp("min", min));
+			geometry::Vector2D max;
+			archive(cereal::make_nvp("max", max));
+
+			rect = geometry::Rect(min, max);
+		}
+		else {
+			rect = geometry::Rect();
+		}
+	}
+};
+
+}
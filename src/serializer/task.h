@@ -8,6 +8,7 @@
 #include <cereal/types/vector.hpp>
 #include <cereal/types/memory.hpp>
 
+#include <unordered_map>
 #include <utility>
 #include <model/task.h>
 
@@ -18,20 +19,19 @@ namespace serializer
 
 using IndexStackList = std::vector<int>;
 
-inline int findPathIndex(const model::Path::ListPtr& paths, const model::Path *wantedPath)
-{
-	const model::Path::ListPtr::const_iterator it = std::find(paths.cbegin(), paths.cend(), wantedPath);
-
-	return std::distance(paths.cbegin(), it);
-}
-
 inline IndexStackList convertPathStackToIndexStack(const model::Path::ListPtr& paths,
 		const model::Path::ListPtr& stack)
 {
+	std::unordered_map<const model::Path *, int> pathIndices;
+	pathIndices.reserve(paths.size());
+	for (int index = 0, size = paths.size(); index < size; ++index) {
+		pathIndices.emplace(paths[index], index);
+	}
+
 	IndexStackList indexStack(stack.size());
 	std::transform(stack.begin(), stack.end(), indexStack.begin(),
-		[&paths](const model::Path *path){
-			return findPathIndex(paths, path);
+		[&pathIndices](const model::Path *path){
+			return pathIndices.at(path);
 		}
 	);
 
@@ -63,19 +63,14 @@ struct Access<model::Task>
 	template <class Archive>
 	void load(Archive &archive, model::Task &task, [[maybe_unused]] std::uint32_t const version) const
 	{
-		model::Layer::ListUPtr layers;
 		archive(cereal::make_nvp("layers", task.m_layers));
-
-		model::Path::ListPtr paths;
-		for (const model::Layer::UPtr &layer : task.m_layers) {
-			layer->forEachChild([&paths](model::Path &path){ paths.push_back(&path); });
-		}
+		// Paths list is built once from layers and used to resolve stack
+		task.initPathsFromLayers();
 
 		IndexStackList indexStack;
 		archive(cereal::make_nvp("stack", indexStack));
-		task.m_stack = convertIndexStackToPathStack(paths, indexStack);
-
-		task.initPathsFromLayers();
+		task.m_stack = convertIndexStackToPathStack(task.m_paths, indexStack);
+		task.updateStackIndices();
 	}
 };
 
@@ -4,27 +4,27 @@
 
 #include <cereal/cereal.hpp>
 
-#include <QVector2D>
+#include <geometry/vector2d.h>
 
 namespace serializer
 {
 
 template<>
-struct Access<QVector2D>
+struct Access<geometry::Vector2D>
 {
 	template <class Archive>
-	void save(Archive &archive, const QVector2D &point, [[maybe_unused]] std::uint32_t const version) const
+	void save(Archive &archive, const geometry::Vector2D &point, [[maybe_unused]] std::uint32_t const version) const
 	{
 		archive(cereal::make_nvp("x", point.x()));
 		archive(cereal::make_nvp("y", point.y()));
 	}
 
 	template <class Archive>
-	void load(Archive &archive, QVector2D &point, [[maybe_unused]] std::uint32_t const version) const
+	void load(Archive &archive, geometry::Vector2D &point, [[maybe_unused]] std::uint32_t const version) const
 	{
-		float x;
+		double x;
 		archive(cereal::make_nvp("x", x));
-		float y;
+		double y;
 		archive(cereal::make_nvp("y", y));
 
 		point.setX(x);
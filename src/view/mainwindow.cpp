@@ -85,10 +85,12 @@ void MainWindow::setupMenuActions()
 	connect(actionRightCutterCompensation, &QAction::triggered, &m_app, &model::Application::rightCutterCompensation);
 	connect(actionResetCutterCompensation, &QAction::triggered, &m_app, &model::Application::resetCutterCompensation);
 	connect(actionPocketSelection, &QAction::triggered, &m_app, &model::Application::pocketSelection);
+	connect(actionPocketAll, &QAction::triggered, &m_app, &model::Application::pocketAll);
 	connect(actionHideSelection, &QAction::triggered, &m_app, &model::Application::hideSelection);
 	connect(actionShowHidden, &QAction::triggered, &m_app, &model::Application::showHidden);
 	connect(actionTransformSelection, &QAction::triggered, this, &MainWindow::transformSelection);
 	connect(actionMirrorSelection, &QAction::triggered, this, &MainWindow::mirrorSelection);
+	connect(actionOptimizeStack, &QAction::triggered, &m_app, &model::Application::optimizeStack);
 }
 
 void MainWindow::setTaskToolsEnabled(bool enabled)
@@ -100,10 +102,12 @@ void MainWindow::setTaskToolsEnabled(bool enabled)
 	actionLeftCutterCompensation->setEnabled(enabled);
 	actionRightCutterCompensation->setEnabled(enabled);
 	actionResetCutterCompensation->setEnabled(enabled);
+	actionPocketAll->setEnabled(enabled);
 	actionHideSelection->setEnabled(enabled);
 	actionShowHidden->setEnabled(enabled);
 	actionTransformSelection->setEnabled(enabled);
 	actionMirrorSelection->setEnabled(enabled);
+	actionOptimizeStack->setEnabled(enabled);
 }
 
 QString MainWindow::defaultFileName(const QString &extension) const
@@ -124,6 +128,7 @@ MainWindow::MainWindow(model::Application &app)
 	connect(&m_app, &model::Application::titleChanged, this, &MainWindow::setWindowTitle);
 	connect(&m_app, &model::Application::documentChanged, this, &MainWindow::documentChanged);
 	connect(&m_app, &model::Application::errorRaised, this, &MainWindow::displayError);
+	connect(&m_app, &model::Application::stackOptimized, this, &MainWindow::stackOptimized);
 }
 
 void MainWindow::openFile()
@@ -211,6 +216,11 @@ void MainWindow::documentChanged(model::Document *newDocument)
 	setTaskToolsEnabled((newDocument != nullptr));
 }
 
+void MainWindow::stackOptimized(float initialTravel, float optimizedTravel)
+{
+	statusbar->showMessage(QString("Rapid travel reduced from %1 to %2").arg(initialTravel).arg(optimizedTravel));
+}
+
 void MainWindow::displayError(const QString &message)
 {
 	QMessageBox messageBox;
@@ -48,6 +48,7 @@ protected Q_SLOTS:
 	void transformSelection();
 	void mirrorSelection();
 	void documentChanged(model::Document *newDocument);
+	void stackOptimized(float initialTravel, float optimizedTravel);
 	void displayError(const QString &message);
 };
 
@@ -122,25 +122,42 @@ void LayerTreeModel::itemClicked(const QModelIndex& index)
 	}
 }
 
-void LayerTreeModel::updateItemSelection(const model::Path &path, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel)
+QModelIndex LayerTreeModel::pathIndex(const model::Path &path) const
 {
 	const std::pair<int, int> indices = m_task.layerAndPathIndexFor(path);
 	const QModelIndex parentIndex = index(indices.first, 0);
-	const QModelIndex childIndex = index(indices.second, 0, parentIndex);
-	selectionModel->select(childIndex, flag);
+	return index(indices.second, 0, parentIndex);
 }
 
-void LayerTreeModel::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
+void LayerTreeModel::updateItemSelection(const model::Path &path, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel)
 {
-	for (const QModelIndex &index : selected.indexes()) {
-		model::Renderable &renderable = *static_cast<model::Renderable *>(index.internalPointer());
-		renderable.setSelected(true);
-	}
+	selectionModel->select(pathIndex(path), flag);
+}
 
-	for (const QModelIndex &index : deselected.indexes()) {
-		model::Renderable &renderable = *static_cast<model::Renderable *>(index.internalPointer());
-		renderable.setSelected(false);
+void LayerTreeModel::updateItemsSelection(const model::Path::ListPtr &paths, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel)
+{
+	QItemSelection selection;
+	for (const model::Path *path : paths) {
+		const QModelIndex index = pathIndex(*path);
+		selection.select(index, index);
 	}
+
+	selectionModel->select(selection, flag);
+}
+
+void LayerTreeModel::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
+{
+	m_task.batchSelectionChange([&selected, &deselected](){
+		for (const QModelIndex &index : selected.indexes()) {
+			model::Renderable &renderable = *static_cast<model::Renderable *>(index.internalPointer());
+			renderable.setSelected(true);
+		}
+
+		for (const QModelIndex &index : deselected.indexes()) {
+			model::Renderable &renderable = *static_cast<model::Renderable *>(index.internalPointer());
+			renderable.setSelected(false);
+		}
+	});
 }
 
 }
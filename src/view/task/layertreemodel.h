@@ -17,6 +17,8 @@ class LayerTreeModel: public QAbstractItemModel
 private:
 	model::Task &m_task;
 
+	QModelIndex pathIndex(const model::Path &path) const;
+
 public:
 	explicit LayerTreeModel(model::Task &task, QObject *parent);
 
@@ -29,6 +31,8 @@ public:
 
 	void itemClicked(const QModelIndex &index);
 	void updateItemSelection(const model::Path &path, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel);
+	/// Update selection of many paths with a single selection model change
+	void updateItemsSelection(const model::Path::ListPtr &paths, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel);
 	void selectionChanged(const QItemSelection &selected, const QItemSelection &deselected);
 };
 
@@ -95,6 +95,13 @@ QModelIndex PathListModel::movePath(const QModelIndex &index, model::Task::MoveD
 	return index;
 }
 
+void PathListModel::stackChanged()
+{
+	// Whole stack was reordered
+	beginResetModel();
+	endResetModel();
+}
+
 void PathListModel::itemClicked(const QModelIndex& index)
 {
 	if ((index.flags() & Qt::ItemIsEnabled) == 0) {
@@ -112,23 +119,41 @@ void PathListModel::itemClicked(const QModelIndex& index)
 	}
 }
 
-void PathListModel::updateItemSelection(const model::Path &path, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel)
+QModelIndex PathListModel::pathIndex(const model::Path &path) const
 {
 	const int row = m_task.pathIndexFor(path);
-	selectionModel->select(index(row, 0), flag);
+	return index(row, 0);
 }
 
-void PathListModel::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
+void PathListModel::updateItemSelection(const model::Path &path, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel)
 {
-	for (const QModelIndex &index : selected.indexes()) {
-		model::Path &path = m_task.pathAt(index.row());
-		path.setSelected(true);
-	}
+	selectionModel->select(pathIndex(path), flag);
+}
 
-	for (const QModelIndex &index : deselected.indexes()) {
-		model::Path &path = m_task.pathAt(index.row());
-		path.setSelected(false);
+void PathListModel::updateItemsSelection(const model::Path::ListPtr &paths, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel)
+{
+	QItemSelection selection;
+	for (const model::Path *path : paths) {
+		const QModelIndex index = pathIndex(*path);
+		selection.select(index, index);
 	}
+
+	selectionModel->select(selection, flag);
+}
+
+void PathListModel::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
+{
+	m_task.batchSelectionChange([this, &selected, &deselected](){
+		for (const QModelIndex &index : selected.indexes()) {
+			model::Path &path = m_task.pathAt(index.row());
+			path.setSelected(true);
+		}
+
+		for (const QModelIndex &index : deselected.indexes()) {
+			model::Path &path = m_task.pathAt(index.row());
+			path.setSelected(false);
+		}
+	});
 }
 
 }
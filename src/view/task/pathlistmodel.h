@@ -17,6 +17,8 @@ class PathListModel : public QAbstractListModel
 private:
 	model::Task &m_task;
 
+	QModelIndex pathIndex(const model::Path &path) const;
+
 public:
 	explicit PathListModel(model::Task &task, QObject *parent);
 
@@ -26,9 +28,12 @@ public:
 	Qt::ItemFlags flags(const QModelIndex &index) const override;
 
 	QModelIndex movePath(const QModelIndex &index, model::Task::MoveDirection direction);
+	void stackChanged();
 	void itemClicked(const QModelIndex &index);
 
 	void updateItemSelection(const model::Path &path, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel);
+	/// Update selection of many paths with a single selection model change
+	void updateItemsSelection(const model::Path::ListPtr &paths, QItemSelectionModel::SelectionFlag flag, QItemSelectionModel *selectionModel);
 	void selectionChanged(const QItemSelection &selected, const QItemSelection &deselected);
 };
 
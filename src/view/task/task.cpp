@@ -27,6 +27,8 @@ void Task::setupController()
 {
 	// Track outside path selection, e.g from graphics view.
 	connect(&task(), &model::Task::pathSelectedChanged, this, &Task::pathSelectedChanged);
+	connect(&task(), &model::Task::pathsSelectedChanged, this, &Task::pathsSelectedChanged);
+	connect(&task(), &model::Task::stackChanged, this, &Task::stackChanged);
 
 	setupTreeViewController(m_pathListModel, pathsTreeView);
 	setupTreeViewController(m_layerTreeModel, layersTreeView);
@@ -41,6 +43,12 @@ void Task::updateItemSelection(const model::Path &path, QItemSelectionModel::Sel
 	m_layerTreeModel->updateItemSelection(path, flag, layersTreeView->selectionModel());
 }
 
+void Task::updateItemsSelection(const model::Path::ListPtr &paths, QItemSelectionModel::SelectionFlag flag)
+{
+	m_pathListModel->updateItemsSelection(paths, flag, pathsTreeView->selectionModel());
+	m_layerTreeModel->updateItemsSelection(paths, flag, layersTreeView->selectionModel());
+}
+
 void Task::documentChanged()
 {
 	setupModel();
@@ -53,6 +61,23 @@ void Task::pathSelectedChanged(model::Path &path, bool selected)
 			selected ? QItemSelectionModel::Select : QItemSelectionModel::Deselect);
 }
 
+void Task::pathsSelectedChanged(const model::Path::ListPtr &paths, bool selected)
+{
+	updateItemsSelection(paths,
+			selected ? QItemSelectionModel::Select : QItemSelectionModel::Deselect);
+}
+
+void Task::stackChanged()
+{
+	m_pathListModel->stackChanged();
+
+	// Restore selection lost by model reset
+	QItemSelectionModel *selectionModel = pathsTreeView->selectionModel();
+	task().forEachSelectedPath([this, selectionModel](const model::Path &path){
+		m_pathListModel->updateItemSelection(path, QItemSelectionModel::Select, selectionModel);
+	});
+}
+
 void Task::moveCurrentPath(model::Task::MoveDirection direction)
 {
 	QItemSelectionModel *selectionModel = pathsTreeView->selectionModel();
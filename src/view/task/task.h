@@ -48,6 +48,7 @@ private:
 	void setupController();
 
 	void updateItemSelection(const model::Path &path, QItemSelectionModel::SelectionFlag flag);
+	void updateItemsSelection(const model::Path::ListPtr &paths, QItemSelectionModel::SelectionFlag flag);
 
 public:
 	explicit Task(model::Application &app);
@@ -58,7 +59,9 @@ protected:
 protected Q_SLOTS:
 	void selectionChanged(const QItemSelection &selected, const QItemSelection &deselected);
 	void pathSelectedChanged(model::Path &path, bool selected);
+	void pathsSelectedChanged(const model::Path::ListPtr &paths, bool selected);
 	void moveCurrentPath(model::Task::MoveDirection direction);
+	void stackChanged();
 };
 
 }
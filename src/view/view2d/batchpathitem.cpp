@@ -0,0 +1,147 @@
+#include <batchpathitem.h>
+#include <bulgepainter.h>
+#include <polylinepathitem.h>
+#include <view/view2d/utils.h>
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include <algorithm>
+
+namespace view::view2d
+{
+
+static const QBrush normalBrush(Qt::white);
+static const QBrush selectBrush(QColor(80, 0, 255));
+static const QPen normalPen(normalBrush, 0.0f);
+static const QPen selectPen(selectBrush, 0.0f);
+
+static const QBrush offsettedNormalBrush(Qt::magenta);
+static const QBrush offsettedSelectBrush(Qt::red);
+static const QPen offsettedNormalPen(offsettedNormalBrush, 0.0f);
+static const QPen offsettedSelectPen(offsettedSelectBrush, 0.0f);
+
+QPainterPath BatchPathItem::tessellatePolyline(const geometry::Polyline &polyline, float maxError)
+{
+	QPainterPath painterPath(toPointF(polyline.start()));
+
+	BulgePainter functor(painterPath, maxError);
+	polyline.forEachBulgeWithArc(functor);
+
+	return painterPath;
+}
+
+BatchPathItem::PathTessellation BatchPathItem::pathTessellation(const model::Path &path, int level)
+{
+	const TessellationKey key(&path, level);
+	if (const PathTessellation *tessellation = m_tessellations.object(key)) {
+		return *tessellation;
+	}
+
+	const float maxError = PolylinePathItem::levelMaxError(level);
+
+	PathTessellation tessellation{tessellatePolyline(path.basePolyline(), maxError), QPainterPath()};
+	if (const model::OffsettedPath *offsettedPath = path.offsettedPath()) {
+		for (const geometry::Polyline &offsettedPolyline : offsettedPath->polylines()) {
+			tessellation.offsetted.addPath(tessellatePolyline(offsettedPolyline, maxError));
+		}
+	}
+
+	// Least recently painted tessellations are evicted above cache element count
+	const int cost = std::max(1, tessellation.base.elementCount() + tessellation.offsetted.elementCount());
+	m_tessellations.insert(key, new PathTessellation(tessellation), cost);
+
+	return tessellation;
+}
+
+void BatchPathItem::removeTessellations(const model::Path *path)
+{
+	for (int level = 0; level < PolylinePathItem::LevelCount; ++level) {
+		m_tessellations.remove(TessellationKey(path, level));
+	}
+}
+
+void BatchPathItem::paintPoint(QPainter *painter, const geometry::Vector2D &point, float pixelSize) const
+{
+	const QPointF center = toPointF(point);
+	const QPointF horizontal(pixelSize, 0.0f);
+	const QPointF vertical(0.0f, pixelSize);
+
+	painter->drawLine(center - horizontal, center + horizontal);
+	painter->drawLine(center - vertical, center + vertical);
+}
+
+void BatchPathItem::paintPath(QPainter *painter, const model::Path &path, int level, float pixelSize)
+{
+	const bool selected = path.selected();
+	const geometry::Polyline &polyline = path.basePolyline();
+
+	painter->setPen(selected ? selectPen : normalPen);
+	if (polyline.isPoint()) {
+		paintPoint(painter, polyline.start(), pixelSize);
+		return;
+	}
+
+	const PathTessellation tessellation = pathTessellation(path, level);
+	painter->drawPath(tessellation.base);
+
+	if (!tessellation.offsetted.isEmpty()) {
+		painter->setPen(selected ? offsettedSelectPen : offsettedNormalPen);
+		painter->drawPath(tessellation.offsetted);
+	}
+}
+
+BatchPathItem::BatchPathItem(model::Task &task)
+	:m_task(task),
+	m_tessellations(CacheMaxElementCount)
+{
+	task.forEachPath([this](model::Path &path){
+		connect(&path, &model::Path::selectedChanged, this, &BatchPathItem::pathChanged);
+		connect(&path, &model::Path::globalVisibilityChanged, this, &BatchPathItem::pathChanged);
+		connect(&path, &model::Path::offsettedPathChanged, this, &BatchPathItem::pathGeometryChanged);
+		connect(&path, &model::Path::basePolylineTransformed, this, &BatchPathItem::pathGeometryChanged);
+		// Address of a deleted path may be reused by a new one
+		connect(&path, &QObject::destroyed, this, [this, path=&path](){ removeTessellations(path); });
+	});
+
+	// Exposed rect is used to cull paths
+	setFlag(ItemUsesExtendedStyleOption);
+}
+
+void BatchPathItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, [[maybe_unused]] QWidget *widget)
+{
+	// Size of one pixel in scene units
+	const float pixelSize = 1.0f / QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+	// Same levels of detail as single path items
+	const int level = PolylinePathItem::levelForMaxError(pixelSize * PolylinePathItem::PixelMaxError);
+
+	// Point crosses are drawn outside of their null bounding rectangle
+	const QRectF exposedRect = option->exposedRect.adjusted(-pixelSize, -pixelSize, pixelSize, pixelSize);
+
+	const model::Task &task = m_task;
+	task.forEachPathIntersecting(toRect(exposedRect), [this, painter, level, pixelSize](const model::Path &path){
+		if (path.globallyVisible()) {
+			paintPath(painter, path, level, pixelSize);
+		}
+	});
+}
+
+QRectF BatchPathItem::boundingRect() const
+{
+	return toRectF(m_task.boundingRect());
+}
+
+void BatchPathItem::pathChanged()
+{
+	update();
+}
+
+void BatchPathItem::pathGeometryChanged()
+{
+	removeTessellations(qobject_cast<const model::Path *>(sender()));
+
+	prepareGeometryChange();
+	update();
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <model/task.h>
+
+#include <QCache>
+#include <QGraphicsItem>
+#include <QPainterPath>
+
+namespace view::view2d
+{
+
+/** @brief Single graphics item drawing all paths of a task, used for huge drawings.
+ * Paths are culled by the task tree of their bounding rectangles and painted at the level of detail
+ * of the current zoom. Tessellations of recently painted paths are cached per level of detail.
+ * No shape is kept, selection is done by viewport on task paths geometry.
+ */
+class BatchPathItem : public QObject, public QGraphicsItem
+{
+	Q_OBJECT;
+
+public:
+	/// Number of paths above which drawings are rendered by a single batch item
+	static constexpr int PathCountThreshold = 20000;
+	/// Maximum number of painter path elements kept in tessellation cache
+	static constexpr int CacheMaxElementCount = 4000000;
+
+private:
+	/// Tessellation of base and offsetted polylines of a path, painter paths are implicitly shared
+	struct PathTessellation
+	{
+		QPainterPath base;
+		QPainterPath offsetted;
+	};
+
+	using TessellationKey = QPair<const model::Path *, int>;
+
+	model::Task &m_task;
+	/// Tessellations by path and level of detail, costing their element count
+	QCache<TessellationKey, PathTessellation> m_tessellations;
+
+	static QPainterPath tessellatePolyline(const geometry::Polyline &polyline, float maxError);
+	PathTessellation pathTessellation(const model::Path &path, int level);
+	/// Drop all levels of a path
+	void removeTessellations(const model::Path *path);
+
+	void paintPoint(QPainter *painter, const geometry::Vector2D &point, float pixelSize) const;
+	void paintPath(QPainter *painter, const model::Path &path, int level, float pixelSize);
+
+public:
+	explicit BatchPathItem(model::Task &task);
+
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+	QRectF boundingRect() const override;
+
+protected Q_SLOTS:
+	void pathChanged();
+	void pathGeometryChanged();
+};
+
+}
@@ -1,54 +1,66 @@
 #include <bulgepainter.h>
+#include <view/view2d/utils.h>
 #include <geometry/arc.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace view::view2d
 {
 
-void BulgePainter::lineToArcPoint(const QVector2D &center, float radius, float angle)
+void BulgePainter::lineToArcPoint(const geometry::Vector2D &center, double radius, double angle)
 {
-	const QVector2D relativeNormalizedPoint(std::cos(angle), std::sin(angle));
-	const QPointF point = (center + relativeNormalizedPoint * radius).toPointF();
+	const geometry::Vector2D relativeNormalizedPoint(std::cos(angle), std::sin(angle));
+	const QPointF point = toPointF(center + relativeNormalizedPoint * radius);
 	m_painter.lineTo(point);
 }
 
-BulgePainter::BulgePainter(QPainterPath &painter)
-	:m_painter(painter)
+double BulgePainter::arcAngleStep(double radius) const
+{
+	// Minimum step avoiding endless tessellation of huge arcs
+	constexpr double minimumAngleStep = 0.0001;
+
+	// Calculate the angle step to not exceed allowed error (distance from line to arc).
+	const double relativeError = std::min(1.0, (double)m_maxError / radius);
+	return std::fmax(std::acos(1.0 - relativeError) * 2.0, minimumAngleStep);
+}
+
+BulgePainter::BulgePainter(QPainterPath &painter, float maxError)
+	:m_painter(painter),
+	m_maxError(maxError)
 {
 }
 
-void BulgePainter::operator()(const geometry::Bulge &bulge)
+void BulgePainter::operator()(const geometry::Bulge &bulge, const std::optional<geometry::Arc> &optArc)
 {
 	if (bulge.isLine()) {
-		const QVector2D &end = bulge.end();
-		m_painter.lineTo(end.toPointF());
+		const geometry::Vector2D &end = bulge.end();
+		m_painter.lineTo(toPointF(end));
 	}
 	else {
-		const geometry::Arc arc = bulge.toArc();
-
-		const float maxError = 0.0001; // TODO const
+		const geometry::Arc &arc = *optArc;
 
-		const float radius = arc.radius();
-		const QVector2D &center = arc.center();
+		const double radius = arc.radius();
+		const geometry::Vector2D &center = arc.center();
 
-		// Calculate the angle step to not exceed allowed error (distance from line to arc).
-		const float angleStep = std::fmax(std::acos(1.0f - maxError) * 2.0f, maxError);
+		const double angleStep = arcAngleStep(radius);
 
 		// Pass by starting point.
-		m_painter.lineTo(arc.start().toPointF());
+		m_painter.lineTo(toPointF(arc.start()));
 
 		if (arc.orientation() == geometry::Orientation::CCW) {
-			for (float angle = arc.startAngle() + angleStep, end = arc.endAngle(); angle < end; angle += angleStep) {
+			for (double angle = arc.startAngle() + angleStep, end = arc.endAngle(); angle < end; angle += angleStep) {
 				lineToArcPoint(center, radius, angle);
 			}
 		}
 		else {
-			for (float angle = arc.startAngle() - angleStep, end = arc.endAngle(); angle > end; angle -= angleStep) {
+			for (double angle = arc.startAngle() - angleStep, end = arc.endAngle(); angle > end; angle -= angleStep) {
 				lineToArcPoint(center, radius, angle);
 			}
 		}
 
 		// Pass by ending point.
-		m_painter.lineTo(arc.end().toPointF());
+		m_painter.lineTo(toPointF(arc.end()));
 	}
 }
 
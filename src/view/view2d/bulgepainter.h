@@ -4,6 +4,8 @@
 
 #include <QPainterPath>
 
+#include <optional>
+
 namespace view::view2d
 {
 
@@ -11,13 +13,17 @@ class BulgePainter
 {
 private:
 	QPainterPath &m_painter;
+	/// Maximum distance between arcs and their tessellation lines
+	const float m_maxError;
 
-	void lineToArcPoint(const QVector2D &center, float radius, float angle);
+	void lineToArcPoint(const geometry::Vector2D &center, double radius, double angle);
+	double arcAngleStep(double radius) const;
 
 public:
-	explicit BulgePainter(QPainterPath &painter);
+	explicit BulgePainter(QPainterPath &painter, float maxError);
 
-	void operator()(const geometry::Bulge &bulge);
+	/// Paint bulge, arc is the one cached by polyline for arc bulges
+	void operator()(const geometry::Bulge &bulge, const std::optional<geometry::Arc> &arc);
 };
 
 }
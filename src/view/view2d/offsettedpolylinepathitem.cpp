@@ -1,5 +1,6 @@
 #include <offsettedpolylinepathitem.h>
 #include <bulgepainter.h>
+#include <view/view2d/utils.h>
 
 #include <geometry/arc.h>
 
@@ -14,6 +15,8 @@ static const QBrush normalBrush(Qt::magenta);
 static const QBrush selectBrush(Qt::red);
 static const QPen normalPen(normalBrush, 0.0f);
 static const QPen selectPen(selectBrush, 0.0f);
+/// Offsetted polylines are only previews, tessellated once at a moderate precision
+static constexpr float maxArcError = 0.001f;
 
 QPainterPath OffsettedPolylinePathItem::paintPath() const
 {
@@ -22,10 +25,10 @@ QPainterPath OffsettedPolylinePathItem::paintPath() const
 	QPainterPath rootPainter;
 
 	for (const geometry::Polyline &polyline : polylines) {
-		QPainterPath painter(polyline.start().toPointF());
+		QPainterPath painter(toPointF(polyline.start()));
 
-		BulgePainter functor(painter);
-		polyline.forEachBulge(functor);
+		BulgePainter functor(painter, maxArcError);
+		polyline.forEachBulgeWithArc(functor);
 
 		rootPainter.addPath(painter);
 	}
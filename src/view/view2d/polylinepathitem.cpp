@@ -1,39 +1,63 @@
 #include <polylinepathitem.h>
 #include <bulgepainter.h>
+#include <view/view2d/utils.h>
 
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include <algorithm>
+#include <cmath>
 
 #include <QDebug> // TODO
 
 namespace view::view2d
 {
 
-QPainterPath PolylinePathItem::paintPath() const
+/// Margin keeping bounding rectangle of axis aligned lines not empty, otherwise they are never painted
+static constexpr float boundingRectMargin = PolylinePathItem::FinestMaxError;
+
+int PolylinePathItem::levelForMaxError(float maxError)
+{
+	const float level = std::floor(std::log(maxError / FinestMaxError) / std::log(LevelErrorRatio));
+	return std::clamp((int)level, 0, LevelCount - 1);
+}
+
+float PolylinePathItem::levelMaxError(int level)
+{
+	return FinestMaxError * std::pow(LevelErrorRatio, level);
+}
+
+QPainterPath PolylinePathItem::paintPath(int level) const
 {
 	const geometry::Polyline &polyline = path().basePolyline();
 
-	QPainterPath painter(polyline.start().toPointF());
+	QPainterPath painter(toPointF(polyline.start()));
 
-	BulgePainter functor(painter);
-	polyline.forEachBulge(functor);
+	BulgePainter functor(painter, levelMaxError(level));
+	polyline.forEachBulgeWithArc(functor);
 
 	return painter;
 }
 
-QPainterPath PolylinePathItem::shapePath(const QPainterPath& basePath)
+const QPainterPath &PolylinePathItem::levelPaintPath(int level)
 {
-	QPainterPathStroker stroker;
-	stroker.setWidth(0.05f); // TODO const or config
-	stroker.setCapStyle(Qt::RoundCap);
-	stroker.setJoinStyle(Qt::RoundJoin);
+	std::optional<QPainterPath> &levelPath = m_levelPaintPaths[level];
+	if (!levelPath) {
+		levelPath = paintPath(level);
+	}
 
-	return stroker.createStroke(basePath);
+	return *levelPath;
 }
 
 void PolylinePathItem::setupPaths()
 {
-	m_paintPath = paintPath();
-	m_shapePath = shapePath(m_paintPath);
+	// Levels are regenerated on demand
+	m_levelPaintPaths.fill(std::nullopt);
+
+	prepareGeometryChange();
+	// Base polyline of lazily loaded paths is decoded on first paint
+	const QRectF boundingRect = toRectF(path().basePolylineBoundingRect());
+	m_boundingRect = boundingRect.adjusted(-boundingRectMargin, -boundingRectMargin, boundingRectMargin, boundingRectMargin);
 }
 
 void PolylinePathItem::updateOffsetedPath()
@@ -72,17 +96,16 @@ void PolylinePathItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
 {
     BasicPathItem::paint(painter, option, widget);
 
-	painter->drawPath(m_paintPath);
-}
+	// Size of one pixel in scene units
+	const float pixelSize = 1.0f / QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+	const int level = levelForMaxError(pixelSize * PixelMaxError);
 
-QPainterPath PolylinePathItem::shape() const
-{
-	return m_shapePath;
+	painter->drawPath(levelPaintPath(level));
 }
 
 QRectF PolylinePathItem::boundingRect() const
 {
-	return m_shapePath.boundingRect();
+	return m_boundingRect;
 }
 
 void PolylinePathItem::basePolylineTransformed()
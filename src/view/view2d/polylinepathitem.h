@@ -3,24 +3,43 @@
 #include <view/view2d/basicpathitem.h>
 #include <view/view2d/offsettedpolylinepathitem.h>
 
+#include <array>
+#include <optional>
+
 namespace view::view2d
 {
 
 /** @brief Graphics path item meant to display polylines with length.
+ * Arcs are tessellated at several levels of detail, generated on first paint at
+ * a zoom needing them, the level with an error below a fraction of pixel is painted.
+ * No shape is kept, selection is done by viewport on task paths geometry.
  */
 class PolylinePathItem : public BasicPathItem
 {
 	Q_OBJECT;
 
+public:
+	/// Tessellation error of finest level of detail
+	static constexpr float FinestMaxError = 0.0001f;
+	/// Tessellation error ratio between two consecutive levels
+	static constexpr float LevelErrorRatio = 4.0f;
+	static constexpr int LevelCount = 8;
+	/// Tessellation error allowed relative to on-screen pixel size
+	static constexpr float PixelMaxError = 0.25f;
+
+	/// Coarsest level with a tessellation error not exceeding max error
+	static int levelForMaxError(float maxError);
+	static float levelMaxError(int level);
+
 private:
-	QPainterPath m_paintPath;
-	QPainterPath m_shapePath;
+	std::array<std::optional<QPainterPath>, LevelCount> m_levelPaintPaths;
+	QRectF m_boundingRect;
 
 	// Item of offsetted polylines of the same path.
 	std::unique_ptr<OffsettedPolylinePathItem> m_offsettedPath;
 
-	QPainterPath paintPath() const;
-	static QPainterPath shapePath(const QPainterPath &basePath);
+	QPainterPath paintPath(int level) const;
+	const QPainterPath &levelPaintPath(int level);
 
 	void setupPaths();
 
@@ -34,7 +53,6 @@ public:
 
 	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
-	QPainterPath shape() const override;
 	QRectF boundingRect() const override;
 
 protected:
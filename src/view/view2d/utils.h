@@ -0,0 +1,32 @@
+#pragma once
+
+#include <geometry/vector2d.h>
+#include <geometry/rect.h>
+
+#include <QPointF>
+#include <QRectF>
+
+namespace view::view2d
+{
+
+inline QPointF toPointF(const geometry::Vector2D &vector)
+{
+	return QPointF(vector.x(), vector.y());
+}
+
+inline geometry::Vector2D toVector2D(const QPointF &point)
+{
+	return geometry::Vector2D(point.x(), point.y());
+}
+
+inline QRectF toRectF(const geometry::Rect &rect)
+{
+	return rect.isValid() ? QRectF(toPointF(rect.min()), toPointF(rect.max())) : QRectF();
+}
+
+inline geometry::Rect toRect(const QRectF &rect)
+{
+	return geometry::Rect(toVector2D(rect.topLeft()), toVector2D(rect.bottomRight()));
+}
+
+}
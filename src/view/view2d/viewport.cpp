@@ -1,6 +1,10 @@
 #include <viewport.h>
 #include <polylinepathitem.h>
 #include <pointpathitem.h>
+#include <batchpathitem.h>
+#include <view/view2d/utils.h>
+
+#include <QLineF>
 
 #include <QDebug> // TODO
 
@@ -13,6 +17,12 @@ constexpr QPoint pointSelectionRectExtend(10, 10);
 
 void Viewport::setupPathItems()
 {
+	// Per path items don't scale to huge drawings
+	if (task().pathCount() > BatchPathItem::PathCountThreshold) {
+		scene()->addItem(new BatchPathItem(task()));
+		return;
+	}
+
 	task().forEachPath(
 		[scene = scene()](model::Path &path) {
 			BasicPathItem *item;
@@ -61,50 +71,63 @@ void Viewport::endRubberBand(const QPoint &mousePos, bool addToSelection)
 {
 	m_rubberBand.end(mousePos, mapToScene(mousePos));
 
+	// Nothing to select before first document
+	if (!document()) {
+		return;
+	}
+
 	// Point selection
 	if (m_rubberBand.empty(rubberBandTolerance)) {
-		// Fake selection area
-		const QRect rect(mousePos - pointSelectionRectExtend, mousePos + pointSelectionRectExtend);
-
-		// Find items in fake selection area
-		const QList<QGraphicsItem *> items = QGraphicsView::items(rect);
-		if (!items.empty()) {
-			// Obtain only the first item.
-			QGraphicsItem *item = items.front();
-
-			if (!addToSelection) {
-				// Clear all and select one in replacive selection
-				scene()->clearSelection();
-				item->setSelected(true);
-			}
-			else {
-				// Toggle selection in additive selection
-				item->setSelected(!item->isSelected());
-			}
+		// Selection tolerance in scene unit
+		const float tolerance = QLineF(mapToScene(QPoint(0, 0)), mapToScene(pointSelectionRectExtend)).length();
+
+		// Find closest path from point
+		model::Path *path = task().nearestVisiblePath(toVector2D(mapToScene(mousePos)), tolerance);
+		if (path) {
+			task().batchSelectionChange([this, path, addToSelection](){
+				if (!addToSelection) {
+					// Clear all and select one in replacive selection
+					task().deselectAll();
+					path->setSelected(true);
+				}
+				else {
+					// Toggle selection in additive selection
+					path->toggleSelect();
+				}
+			});
 		}
 	}
 	// Area selection
 	else {
-		// Create a path with selection area
-		QPainterPath path;
-		path.addRect(m_rubberBand.rect());
-
-		scene()->setSelectionArea(path, addToSelection ? Qt::AddToSelection : Qt::ReplaceSelection);
+		task().selectArea(toRect(m_rubberBand.rect()), addToSelection);
 	}
 }
 
 void Viewport::selectAllItems()
 {
-	for (QGraphicsItem *item : scene()->items()) {
-		item->setSelected(true);
+	if (!document()) {
+		return;
 	}
+
+	task().selectAll();
 }
 
 void Viewport::deselecteAllItems()
 {
-	for (QGraphicsItem *item : scene()->selectedItems()) {
-		item->setSelected(false);
+	if (!document()) {
+		return;
+	}
+
+	task().deselectAll();
+}
+
+void Viewport::invertItemsSelection()
+{
+	if (!document()) {
+		return;
 	}
+
+	task().invertSelection();
 }
 
 void Viewport::setupModel()
@@ -116,7 +139,7 @@ void Viewport::setupModel()
 	setupPathItems();
 
 	// Expand scene rect by margin allowing moving out of bound
-	const QRectF originalRect = scene()->itemsBoundingRect();
+	const QRectF originalRect = toRectF(task().boundingRect());
 	const QRectF expandedRect = originalRect.adjusted(-2000.0f, -2000.0f, 2000.0f, 2000.0f);
 	setSceneRect(expandedRect);
 }
@@ -125,7 +148,7 @@ void Viewport::fitItemsInView()
 {
 	setTransformationAnchor(NoAnchor);
 
-	const QRectF boundingRect = scene()->itemsBoundingRect();
+	const QRectF boundingRect = toRectF(task().boundingRect());
 	centerOn(boundingRect.center());
 	fitInView(boundingRect, Qt::KeepAspectRatio);
 
@@ -334,6 +357,9 @@ void Viewport::keyPressEvent(QKeyEvent *event)
 	if (key == Qt::Key_A && modifier & Qt::ControlModifier) {
 		selectAllItems();
 	}
+	else if (key == Qt::Key_I && modifier & Qt::ControlModifier) {
+		invertItemsSelection();
+	}
 	else if (key == Qt::Key_Escape) {
 		deselecteAllItems();
 	}
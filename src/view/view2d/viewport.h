@@ -35,6 +35,7 @@ private:
 
 	void selectAllItems();
 	void deselecteAllItems();
+	void invertItemsSelection();
 
 	void setupModel();
 
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <model/application.h>
+
+#include <exporter/dxfplot/exporter.h>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <fstream>
+
+class ApplicationTest : public ::testing::Test
+{
+protected:
+	int m_argc = 1;
+	char m_argv0[16] = "dxfplotter-test";
+	char *m_argv[1] = {m_argv0};
+	QCoreApplication m_qapp{m_argc, m_argv};
+	QTemporaryDir m_dir;
+
+	static void SetUpTestSuite()
+	{
+		// Keep user configuration untouched
+		QStandardPaths::setTestModeEnabled(true);
+	}
+
+	/// Save a binary project using tool and profile of application config
+	void saveBinaryProject(const model::Application &app, const std::string &fileName) const
+	{
+		geometry::Polyline::List polylines;
+		polylines.emplace_back(geometry::Bulge::List{geometry::Bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 0), 0)});
+
+		model::Layer::ListUPtr layers;
+		layers.push_back(std::make_unique<model::Layer>("layer", model::Path::FromPolylines(std::move(polylines), app.defaultPathSettings(), "layer")));
+
+		const model::Document document(std::make_unique<model::Task>(std::move(layers)), app.defaultToolConfig(), app.defaultProfileConfig());
+
+		std::ofstream output(fileName, std::ios::binary);
+		exporter::dxfplot::Exporter exporter(exporter::dxfplot::Exporter::Format::Binary);
+		exporter(document, output);
+	}
+};
+
+TEST_F(ApplicationTest, shouldLoadBinaryProjectFile)
+{
+	model::Application app;
+
+	const QString fileName = m_dir.filePath("project.dxfplot");
+	saveBinaryProject(app, fileName.toStdString());
+
+	EXPECT_TRUE(app.loadFile(fileName));
+	EXPECT_EQ(app.lastHandledFileBaseName(), m_dir.filePath("project"));
+}
+
+TEST_F(ApplicationTest, shouldLoadBinaryProjectFileWithoutExtension)
+{
+	model::Application app;
+
+	const QString fileName = m_dir.filePath("project");
+	saveBinaryProject(app, fileName.toStdString());
+
+	EXPECT_TRUE(app.loadFile(fileName));
+}
+
+TEST_F(ApplicationTest, shouldFailLoadingCorruptedProjectFile)
+{
+	model::Application app;
+
+	const QString fileName = m_dir.filePath("corrupted.dxfplot");
+	{
+		std::ofstream output(fileName.toStdString(), std::ios::binary);
+		output << "DXFPLOTB";
+	}
+
+	EXPECT_FALSE(app.loadFile(fileName));
+	EXPECT_TRUE(app.lastHandledFileBaseName().isEmpty());
+}
+
+TEST_F(ApplicationTest, shouldCompleteQueuedSaveBeforeOpeningAnotherFile)
+{
+	model::Application app;
+
+	const QString fileName = m_dir.filePath("project.dxfplot");
+	saveBinaryProject(app, fileName.toStdString());
+	ASSERT_TRUE(app.loadFile(fileName));
+
+	// Second save is queued if first one is still running
+	const QString firstFileName = m_dir.filePath("first.dxfplot");
+	const QString secondFileName = m_dir.filePath("second.dxfplot");
+	EXPECT_TRUE(app.saveToDxfplot(firstFileName));
+	EXPECT_TRUE(app.saveToDxfplot(secondFileName));
+
+	EXPECT_TRUE(app.loadFile(secondFileName));
+	EXPECT_TRUE(QFile::exists(firstFileName));
+}
+
+TEST_F(ApplicationTest, shouldSaveOverMappedProjectFile)
+{
+	model::Application app;
+
+	const QString fileName = m_dir.filePath("project.dxfplot");
+	saveBinaryProject(app, fileName.toStdString());
+	ASSERT_TRUE(app.loadFile(fileName));
+
+	EXPECT_TRUE(app.saveToDxfplot(fileName));
+	EXPECT_TRUE(app.loadFile(fileName));
+}
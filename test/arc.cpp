@@ -1,8 +1,8 @@
 #include <gtest/gtest.h>
 #include <geometry/bulge.h>
 
-constexpr QVector2D point1(-1.0f, -0.5f);
-constexpr QVector2D point2(1.0f, 0.5f);
+constexpr geometry::Vector2D point1(-1.0f, -0.5f);
+constexpr geometry::Vector2D point2(1.0f, 0.5f);
 
 TEST(ArcTest, HalfCcwCircleBulgeConvertToArcMatchBulge)
 {
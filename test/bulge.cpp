@@ -1,10 +1,10 @@
 #include <gtest/gtest.h>
 #include <geometry/bulge.h>
 
-constexpr QVector2D point1(1.2, 3.4);
-constexpr QVector2D point2(4.5, 6.7);
-constexpr QVector2D point3(7.8, 9.1);
-constexpr QVector2D point4(11.0, 12.0);
+constexpr geometry::Vector2D point1(1.2, 3.4);
+constexpr geometry::Vector2D point2(4.5, 6.7);
+constexpr geometry::Vector2D point3(7.8, 9.1);
+constexpr geometry::Vector2D point4(11.0, 12.0);
 
 static const geometry::Bulge bulge1(point1, point2, 0.0f);
 static const geometry::Bulge bulge2(point2, point3, 1.0f);
@@ -38,3 +38,61 @@ TEST(BulgeTest, LinifyBecomeIsLine)
 
 	ASSERT_TRUE(bulge.isLine());
 }
+
+TEST(BulgeTest, PointAtMiddleOfHalfCircle)
+{
+	const geometry::Bulge bulge(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(2.0f, 0.0f), 1.0f);
+	const geometry::Vector2D middle = bulge.pointAt(0.5f);
+
+	EXPECT_NEAR(middle.x(), 1.0f, 1e-5f);
+	EXPECT_NEAR(middle.y(), -1.0f, 1e-5f);
+}
+
+TEST(BulgeTest, ClosestPointRatioProjectsOnBulge)
+{
+	const geometry::Bulge arc(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(2.0f, 0.0f), 1.0f);
+	EXPECT_NEAR(arc.closestPointRatio(geometry::Vector2D(1.0f, -5.0f)), 0.5f, 1e-5f);
+	// Projection outside of arc
+	EXPECT_FLOAT_EQ(arc.closestPointRatio(geometry::Vector2D(-1.0f, 1.0f)), 0.0f);
+
+	EXPECT_FLOAT_EQ(bulge1.closestPointRatio(point1 - geometry::Vector2D(1.0f, 1.0f)), 0.0f);
+	EXPECT_NEAR(bulge1.closestPointRatio((point1 + point2) / 2.0f), 0.5f, 1e-5f);
+}
+
+TEST(BulgeTest, SplitKeepsArcGeometry)
+{
+	const geometry::Bulge bulge(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(2.0f, 0.0f), 1.0f);
+	const geometry::Bulge::Pair splitted = bulge.split(0.5f);
+
+	EXPECT_EQ(splitted[0].start(), bulge.start());
+	EXPECT_EQ(splitted[0].end(), splitted[1].start());
+	EXPECT_EQ(splitted[1].end(), bulge.end());
+	EXPECT_NEAR(splitted[0].tangent(), std::tan(M_PI / 8.0), 1e-5f);
+	EXPECT_NEAR(splitted[1].tangent(), std::tan(M_PI / 8.0), 1e-5f);
+	EXPECT_NEAR(splitted[0].length() + splitted[1].length(), bulge.length(), 1e-5f);
+}
+
+TEST(BulgeTest, DistanceToPointOfArc)
+{
+	const geometry::Bulge arc(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(2.0f, 0.0f), 1.0f);
+	EXPECT_NEAR(arc.distanceToPoint(geometry::Vector2D(1.0f, 0.0f)), 1.0f, 1e-5f);
+	EXPECT_NEAR(arc.distanceToPoint(geometry::Vector2D(1.0f, -3.0f)), 2.0f, 1e-5f);
+	// Closest point is an end
+	EXPECT_NEAR(arc.distanceToPoint(geometry::Vector2D(-1.0f, 1.0f)), std::sqrt(2.0f), 1e-5f);
+}
+
+TEST(BulgeTest, IntersectsRectCrossedWithoutEndsInside)
+{
+	const geometry::Bulge arc(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(2.0f, 0.0f), 1.0f);
+	// Rectangle around bottom of the half circle
+	EXPECT_TRUE(arc.intersects(geometry::Rect(geometry::Vector2D(0.5f, -1.5f), geometry::Vector2D(1.5f, -0.5f))));
+	// Rectangle inside the half circle touching nothing
+	EXPECT_FALSE(arc.intersects(geometry::Rect(geometry::Vector2D(0.8f, -0.4f), geometry::Vector2D(1.2f, -0.1f))));
+	// Rectangle above the chord, in arc bounding rectangle but on the missing half of the circle
+	EXPECT_FALSE(arc.intersects(geometry::Rect(geometry::Vector2D(0.5f, 0.5f), geometry::Vector2D(1.5f, 1.5f))));
+
+	const geometry::Bulge line(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(2.0f, 2.0f), 0.0f);
+	EXPECT_TRUE(line.intersects(geometry::Rect(geometry::Vector2D(0.5f, 0.5f), geometry::Vector2D(1.5f, 1.5f))));
+	EXPECT_TRUE(line.intersects(geometry::Rect(geometry::Vector2D(0.9f, -1.0f), geometry::Vector2D(1.1f, 3.0f))));
+	EXPECT_FALSE(line.intersects(geometry::Rect(geometry::Vector2D(1.5f, 0.0f), geometry::Vector2D(2.0f, 1.0f))));
+}
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+
+#include <geometry/cleaner.h>
+
+#include <chrono>
+#include <list>
+#include <random>
+
+/// Straightforward merging of small bulges, smallest first, used as reference.
+static geometry::Polyline referenceLengthClean(const geometry::Polyline &polyline, float minimumLength)
+{
+	std::list<geometry::Bulge> bulges;
+	polyline.forEachBulge([&bulges](const geometry::Bulge &bulge){ bulges.push_back(bulge); });
+
+	while (bulges.size() > 1) {
+		const auto smallestIt = std::min_element(bulges.begin(), bulges.end(), [](const geometry::Bulge &b1, const geometry::Bulge &b2){
+			return b1.length() < b2.length();
+		});
+		if (smallestIt->length() >= minimumLength) {
+			break;
+		}
+
+		if (smallestIt == bulges.begin()) {
+			const auto nextIt = std::next(smallestIt);
+			*nextIt = nextIt->extendStart(smallestIt->start());
+		}
+		else {
+			const auto previousIt = std::prev(smallestIt);
+			*previousIt = previousIt->extendEnd(smallestIt->end());
+		}
+		bulges.erase(smallestIt);
+	}
+
+	return geometry::Polyline(geometry::Bulge::List(bulges.begin(), bulges.end()));
+}
+
+/// Polyline zigzaging along x with random segment lengths
+static geometry::Polyline createRandomPolyline(int nbBulges, float maxLength, unsigned int seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<float> distribution(0.0f, maxLength);
+
+	geometry::Bulge::List bulges;
+	geometry::Vector2D point(0.0f, 0.0f);
+	for (int i = 0; i < nbBulges; ++i) {
+		const geometry::Vector2D next = point + geometry::Vector2D(distribution(generator), (i % 2) ? distribution(generator) : -distribution(generator));
+		bulges.emplace_back(point, next, 0.0f);
+		point = next;
+	}
+
+	return geometry::Polyline(std::move(bulges));
+}
+
+TEST(CleanerTest, shouldMergeSmallBulgesIntoNeighbour)
+{
+	const geometry::Vector2D p1(0.0f, 0.0f);
+	const geometry::Vector2D p2(0.1f, 0.0f);
+	const geometry::Vector2D p3(5.0f, 0.0f);
+	const geometry::Vector2D p4(5.0f, 5.0f);
+	geometry::Polyline::List polylines{geometry::Polyline({
+		geometry::Bulge(p1, p2, 0.0f),
+		geometry::Bulge(p2, p3, 0.0f),
+		geometry::Bulge(p3, p4, 0.0f)
+	})};
+
+	geometry::Cleaner cleaner(std::move(polylines), 1.0f, 0.0f);
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+
+	ASSERT_EQ(cleaned.size(), 1);
+	const geometry::Polyline expected({
+		geometry::Bulge(p1, p3, 0.0f),
+		geometry::Bulge(p3, p4, 0.0f)
+	});
+	EXPECT_EQ(cleaned.front(), expected);
+}
+
+TEST(CleanerTest, shouldKeepOneBulgeOfPointPolyline)
+{
+	const geometry::Vector2D p1(0.0f, 0.0f);
+	const geometry::Vector2D p2(0.1f, 0.0f);
+	geometry::Polyline::List polylines{geometry::Polyline({
+		geometry::Bulge(p1, p2, 0.0f),
+		geometry::Bulge(p2, p1, 0.0f)
+	})};
+
+	geometry::Cleaner cleaner(std::move(polylines), 1.0f, 0.0f);
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+
+	int nbBulges = 0;
+	cleaned.front().forEachBulge([&nbBulges](const geometry::Bulge &){ ++nbBulges; });
+	EXPECT_EQ(nbBulges, 1);
+}
+
+TEST(CleanerTest, shouldMatchReferenceMerging)
+{
+	for (unsigned int seed = 0; seed < 20; ++seed) {
+		const geometry::Polyline polyline = createRandomPolyline(500, 2.0f, seed);
+
+		geometry::Cleaner cleaner(geometry::Polyline::List{polyline}, 1.0f, 0.0f);
+		const geometry::Polyline::List cleaned = cleaner.polylines();
+
+		ASSERT_EQ(cleaned.size(), 1);
+		EXPECT_EQ(cleaned.front(), referenceLengthClean(polyline, 1.0f)) << "seed " << seed;
+	}
+}
+
+/// Timing of cleaning, run on demand with --gtest_also_run_disabled_tests
+TEST(CleanerTest, DISABLED_shouldCleanHugeTessellatedPolyline)
+{
+	constexpr int nbBulges = 100000;
+	// Most bulges are smaller than minimum length as in tessellated exports
+	const geometry::Polyline polyline = createRandomPolyline(nbBulges, 0.2f, 42);
+
+	const auto start = std::chrono::steady_clock::now();
+	geometry::Cleaner cleaner(geometry::Polyline::List{polyline}, 1.0f, 0.0f);
+	const auto end = std::chrono::steady_clock::now();
+
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+	ASSERT_EQ(cleaned.size(), 1);
+	EXPECT_EQ(cleaned.front().start(), polyline.start());
+	EXPECT_EQ(cleaned.front().end(), polyline.end());
+
+	int nbCleanedBulges = 0;
+	cleaned.front().forEachBulge([&nbCleanedBulges](const geometry::Bulge &){
+		++nbCleanedBulges;
+	});
+	EXPECT_LT(nbCleanedBulges, nbBulges);
+
+	RecordProperty("milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+static int bulgeCount(const geometry::Polyline &polyline)
+{
+	int count = 0;
+	polyline.forEachBulge([&count](const geometry::Bulge &){ ++count; });
+
+	return count;
+}
+
+/// Tessellation of a circle arc in a number of lines
+static geometry::Bulge::List createTessellatedArc(const geometry::Vector2D &center, float radius, float startAngle, float endAngle, int nbLines)
+{
+	geometry::Bulge::List bulges;
+	for (int i = 0; i < nbLines; ++i) {
+		const float angle1 = startAngle + (endAngle - startAngle) * i / nbLines;
+		const float angle2 = startAngle + (endAngle - startAngle) * (i + 1) / nbLines;
+		bulges.emplace_back(center + radius * geometry::Vector2D(std::cos(angle1), std::sin(angle1)),
+			center + radius * geometry::Vector2D(std::cos(angle2), std::sin(angle2)), 0.0f);
+	}
+
+	return bulges;
+}
+
+TEST(CleanerTest, shouldMergeCollinearLines)
+{
+	geometry::Bulge::List bulges;
+	for (int i = 0; i < 10; ++i) {
+		bulges.emplace_back(geometry::Vector2D(i, 0.0f), geometry::Vector2D(i + 1, 0.0f), 0.0f);
+	}
+	bulges.emplace_back(geometry::Vector2D(10.0f, 0.0f), geometry::Vector2D(10.0f, 5.0f), 0.0f);
+
+	geometry::Cleaner cleaner(geometry::Polyline::List{geometry::Polyline(std::move(bulges))}, 0.01f, 0.01f, 0.001f);
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+
+	const geometry::Polyline expected({
+		geometry::Bulge(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(10.0f, 0.0f), 0.0f),
+		geometry::Bulge(geometry::Vector2D(10.0f, 0.0f), geometry::Vector2D(10.0f, 5.0f), 0.0f)
+	});
+	EXPECT_EQ(cleaned.front(), expected);
+}
+
+TEST(CleanerTest, shouldFitArcsOnTessellatedCircle)
+{
+	const geometry::Vector2D center(3.0f, 4.0f);
+	const float radius = 10.0f;
+	// Circle made of two tessellated half circles
+	geometry::Bulge::List bulges = createTessellatedArc(center, radius, 0.0f, M_PI, 200);
+	const geometry::Bulge::List secondHalf = createTessellatedArc(center, radius, M_PI, 2.0f * M_PI, 200);
+	bulges.insert(bulges.end(), secondHalf.begin(), secondHalf.end());
+	bulges.back().end() = bulges.front().start();
+
+	const geometry::Polyline polyline(std::move(bulges));
+	geometry::Cleaner cleaner(geometry::Polyline::List{polyline}, 0.01f, 0.01f, 0.001f);
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+
+	const geometry::Polyline &fitted = cleaned.front();
+	EXPECT_LE(bulgeCount(fitted), 3);
+	EXPECT_TRUE(fitted.isClosed());
+	EXPECT_NEAR(fitted.length(), 2.0f * M_PI * radius, 0.01f);
+	fitted.forEachBulge([&center, radius](const geometry::Bulge &bulge){
+		ASSERT_TRUE(bulge.isArc());
+		EXPECT_EQ(bulge.orientation(), geometry::Orientation::CCW);
+		EXPECT_NEAR(bulge.pointAt(0.5f).distanceToPoint(center), radius, 0.001f);
+	});
+}
+
+TEST(CleanerTest, shouldNotFitArcsOnCoarsePolygon)
+{
+	// Hexagon vertices are on a circle but its sides are far from it
+	const geometry::Polyline polyline(createTessellatedArc(geometry::Vector2D(0.0f, 0.0f), 10.0f, 0.0f, 2.0f * M_PI, 6));
+
+	geometry::Cleaner cleaner(geometry::Polyline::List{polyline}, 0.01f, 0.01f, 0.001f);
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+
+	EXPECT_EQ(cleaned.front(), polyline);
+}
+
+TEST(CleanerTest, shouldFitArcBetweenLinesOfFillet)
+{
+	// Square corner rounded by a tessellated quarter circle
+	geometry::Bulge::List bulges{geometry::Bulge(geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(8.0f, 0.0f), 0.0f)};
+	const geometry::Bulge::List fillet = createTessellatedArc(geometry::Vector2D(8.0f, 2.0f), 2.0f, -M_PI_2, 0.0f, 32);
+	bulges.insert(bulges.end(), fillet.begin(), fillet.end());
+	bulges.emplace_back(fillet.back().end(), geometry::Vector2D(10.0f, 10.0f), 0.0f);
+
+	geometry::Cleaner cleaner(geometry::Polyline::List{geometry::Polyline(std::move(bulges))}, 0.01f, 0.01f, 0.001f);
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+
+	const geometry::Polyline &fitted = cleaned.front();
+	ASSERT_EQ(bulgeCount(fitted), 3);
+
+	int index = 0;
+	fitted.forEachBulge([&index](const geometry::Bulge &bulge){
+		EXPECT_EQ(bulge.isArc(), index == 1);
+		++index;
+	});
+}
+
+TEST(CleanerTest, shouldKeepArcsTangentToPreviousBulge)
+{
+	// Fillet rotated away from tangency with its line, joint is still smoother than tessellation
+	const float rotation = 0.03f;
+	const geometry::Bulge::List fillet = createTessellatedArc(geometry::Vector2D(8.0f, 2.0f), 2.0f, -M_PI_2 - rotation, 0.0f, 32);
+	geometry::Bulge::List bulges{geometry::Bulge(fillet.front().start() - geometry::Vector2D(8.0f, 0.0f), fillet.front().start(), 0.0f)};
+	bulges.insert(bulges.end(), fillet.begin(), fillet.end());
+
+	const float tolerance = 0.001f;
+	geometry::Cleaner cleaner(geometry::Polyline::List{geometry::Polyline(std::move(bulges))}, 0.01f, 0.01f, tolerance);
+	const geometry::Bulge::List fitted = cleaner.polylines().front().bulges();
+
+	for (int index = 1, size = fitted.size(); index < size; ++index) {
+		const geometry::Bulge &previous = fitted[index - 1];
+		const geometry::Bulge &bulge = fitted[index];
+		if (bulge.isArc()) {
+			const double previousAngle = geometry::LineAngle(previous.end() - previous.start()) + 2.0 * std::atan(previous.tangent());
+			const double startAngle = geometry::LineAngle(bulge.end() - bulge.start()) - 2.0 * std::atan(bulge.tangent());
+			EXPECT_LE(std::abs(std::remainder(startAngle - previousAngle, 2.0 * M_PI)), 0.011);
+		}
+	}
+}
+
+TEST(CleanerTest, shouldKeepPolylinesOrder)
+{
+	geometry::Polyline::List polylines;
+	for (unsigned int seed = 0; seed < 200; ++seed) {
+		polylines.push_back(createRandomPolyline(100 + seed, 2.0f, seed));
+	}
+
+	geometry::Cleaner cleaner(geometry::Polyline::List(polylines), 1.0f, 0.01f, 0.001f);
+	const geometry::Polyline::List cleaned = cleaner.polylines();
+
+	ASSERT_EQ(cleaned.size(), polylines.size());
+	for (int i = 0, size = polylines.size(); i < size; ++i) {
+		geometry::Cleaner singleCleaner(geometry::Polyline::List{polylines[i]}, 1.0f, 0.01f, 0.001f);
+		EXPECT_EQ(cleaned[i], singleCleaner.polylines().front());
+	}
+}
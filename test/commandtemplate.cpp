@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <exporter/gcode/commandtemplate.h>
+#include <common/exception.h>
+
+#include <fmt/format.h>
+
+#include <random>
+
+TEST(CommandTemplateTest, shouldWriteFixedPrecisionSameAsFmt)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-10000.0f, 10000.0f);
+
+	const float specialValues[] = {0.0f, -0.0f, -0.0001f, 0.125f, 0.375f, 2.5f, 0.0005f, 1e10f, 1e30f};
+
+	for (int precision = 0; precision < 10; ++precision) {
+		for (const float value : specialValues) {
+			std::string output;
+			exporter::gcode::writeFixedPrecision(output, value, precision);
+			EXPECT_EQ(fmt::format("{:.{}f}", value, precision), output);
+		}
+
+		for (int i = 0; i < 10000; ++i) {
+			const float value = distribution(generator);
+			std::string output;
+			exporter::gcode::writeFixedPrecision(output, value, precision);
+			EXPECT_EQ(fmt::format("{:.{}f}", value, precision), output);
+		}
+	}
+}
+
+TEST(CommandTemplateTest, shouldRenderSameAsFmt)
+{
+	const exporter::gcode::CommandTemplate command("G2 X {X:.3f} Y {Y:.3f} I {I:.4f} J {J:.1f} F {F} {{S}} {S:+08.2f}", {"X", "Y", "I", "J", "F", "S"});
+
+	exporter::gcode::CommandArguments arguments;
+	arguments.X = 1.23456f;
+	arguments.Y = -0.0f;
+	arguments.I = 12.5f;
+	arguments.J = 0.25f;
+	arguments.F = 100.0f;
+	arguments.S = 3.14159f;
+
+	std::string output;
+	command.render(output, arguments);
+
+	EXPECT_EQ(fmt::format("G2 X {:.3f} Y {:.3f} I {:.4f} J {:.1f} F {} {{S}} {:+08.2f}", arguments.X, arguments.Y,
+		arguments.I, arguments.J, arguments.F, arguments.S), output);
+}
+
+TEST(CommandTemplateTest, shouldRenderFormatWithoutArguments)
+{
+	const exporter::gcode::CommandTemplate command("M5", {});
+
+	std::string output;
+	command.render(output, exporter::gcode::CommandArguments());
+
+	EXPECT_EQ("M5", output);
+}
+
+TEST(CommandTemplateTest, shouldThrowOnCompileWithUnknownArgument)
+{
+	EXPECT_THROW(exporter::gcode::CommandTemplate("G0 X {X:.3f} Z {Z:.3f}", {"X", "Y"}), common::GCodeFormatException);
+	EXPECT_THROW(exporter::gcode::CommandTemplate("G0 X {W}", {"X", "Y"}), common::GCodeFormatException);
+}
+
+TEST(CommandTemplateTest, shouldThrowOnCompileWithInvalidFormat)
+{
+	EXPECT_THROW(exporter::gcode::CommandTemplate("G0 X {X:.3f", {"X"}), common::GCodeFormatException);
+	EXPECT_THROW(exporter::gcode::CommandTemplate("G0 X }", {"X"}), common::GCodeFormatException);
+	EXPECT_THROW(exporter::gcode::CommandTemplate("G0 X {X:.3z}", {"X"}), common::GCodeFormatException);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <geometry/containmenttree.h>
+
+static geometry::Polyline createSquare(float x, float y, float size)
+{
+	const geometry::Vector2D p1(x, y);
+	const geometry::Vector2D p2(x + size, y);
+	const geometry::Vector2D p3(x + size, y + size);
+	const geometry::Vector2D p4(x, y + size);
+
+	return geometry::Polyline({
+		geometry::Bulge(p1, p2, 0.0f),
+		geometry::Bulge(p2, p3, 0.0f),
+		geometry::Bulge(p3, p4, 0.0f),
+		geometry::Bulge(p4, p1, 0.0f)
+	});
+}
+
+static geometry::Polyline createCircle(const geometry::Vector2D &center, float radius)
+{
+	const geometry::Vector2D p1 = center - geometry::Vector2D(radius, 0.0f);
+	const geometry::Vector2D p2 = center + geometry::Vector2D(radius, 0.0f);
+
+	return geometry::Polyline({
+		geometry::Bulge(p1, p2, 1.0f),
+		geometry::Bulge(p2, p1, 1.0f)
+	});
+}
+
+TEST(ContainmentTreeTest, shouldNestContainedPolylines)
+{
+	const geometry::Polyline::List polylines{
+		createSquare(4.0f, 4.0f, 2.0f), // Inside hole
+		createSquare(0.0f, 0.0f, 10.0f), // Outer border
+		createSquare(20.0f, 0.0f, 10.0f), // Separate part
+		createSquare(2.0f, 2.0f, 6.0f), // Hole of outer border
+		createCircle(geometry::Vector2D(25.0f, 5.0f), 2.0f) // Hole of separate part
+	};
+
+	geometry::Polyline::ListCPtr polylinePtrs;
+	for (const geometry::Polyline &polyline : polylines) {
+		polylinePtrs.push_back(&polyline);
+	}
+
+	const geometry::ContainmentTree tree(polylinePtrs);
+
+	EXPECT_EQ(tree.parent(1), -1);
+	EXPECT_EQ(tree.parent(2), -1);
+	EXPECT_EQ(tree.parent(3), 1);
+	EXPECT_EQ(tree.parent(0), 3);
+	EXPECT_EQ(tree.parent(4), 2);
+	EXPECT_EQ(tree.depth(0), 2);
+
+	const geometry::ContainmentTree::Region::List regions = tree.regions();
+	ASSERT_EQ(regions.size(), 3);
+	EXPECT_EQ(regions[0].border, 0);
+	EXPECT_TRUE(regions[0].islands.empty());
+	EXPECT_EQ(regions[1].border, 1);
+	EXPECT_EQ(regions[1].islands, std::vector<int>{3});
+	EXPECT_EQ(regions[2].border, 2);
+	EXPECT_EQ(regions[2].islands, std::vector<int>{4});
+}
+
+TEST(ContainmentTreeTest, shouldNotNestPolylinesOnlyInsideBoundingRect)
+{
+	const geometry::Vector2D p1(0.0f, 0.0f);
+	const geometry::Vector2D p2(10.0f, 0.0f);
+	const geometry::Vector2D p3(0.0f, 10.0f);
+	const geometry::Polyline triangle({
+		geometry::Bulge(p1, p2, 0.0f),
+		geometry::Bulge(p2, p3, 0.0f),
+		geometry::Bulge(p3, p1, 0.0f)
+	});
+	// Bounding rectangle is inside triangle one but square is outside triangle
+	const geometry::Polyline outsideSquare = createSquare(7.0f, 7.0f, 1.0f);
+	const geometry::Polyline insideCircle = createCircle(geometry::Vector2D(2.0f, 2.0f), 1.0f);
+
+	const geometry::Polyline::ListCPtr polylines{&triangle, &outsideSquare, &insideCircle};
+	const geometry::ContainmentTree tree(polylines);
+
+	EXPECT_EQ(tree.parent(1), -1);
+	EXPECT_EQ(tree.parent(2), 0);
+	EXPECT_EQ(tree.roots().size(), 2);
+}
@@ -3,8 +3,21 @@
 #include <exporter/dxfplot/exporter.h>
 #include <importer/dxfplot/importer.h>
 
+#include <model/snapshot.h>
+
+#include <serializer/chunks.h>
+#include <serializer/format.h>
+#include <serializer/task.h>
+
 #include <common/exception.h>
 
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
+
+#include <QDir>
+#include <QFile>
+
+#include <fstream>
 #include <sstream>
 
 
@@ -12,7 +25,7 @@ TEST_F(ExporterFixture, shouldThrowExceptionWhenToolNotFound)
 {
 	std::ostringstream output;
 
-	const geometry::Bulge bulge(QVector2D(0, 0), QVector2D(1, 1), 0);
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
 	geometry::Polyline polyline({bulge});
 
 	createTaskFromPolyline(std::move(polyline));
@@ -39,7 +52,7 @@ TEST_F(ExporterFixture, shouldThrowExceptionWhenProfileNotFound)
 {
 	std::ostringstream output;
 
-	const geometry::Bulge bulge(QVector2D(0, 0), QVector2D(1, 1), 0);
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
 	geometry::Polyline polyline({bulge});
 
 	createTaskFromPolyline(std::move(polyline));
@@ -66,7 +79,7 @@ TEST_F(ExporterFixture, shouldReimportDocumentWithToolAndProfileConfig)
 {
 	std::ostringstream output;
 
-	const geometry::Bulge bulge(QVector2D(0, 0), QVector2D(1, 1), 0);
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
 	geometry::Polyline polyline({bulge});
 
 	createTaskFromPolyline(std::move(polyline));
@@ -97,7 +110,7 @@ TEST_F(ExporterFixture, shouldReimportDocumentWithSameTask)
 {
 	std::ostringstream output;
 
-	const geometry::Bulge bulge(QVector2D(0, 0), QVector2D(1, 1), 0);
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
 	geometry::Polyline polyline({bulge});
 
 	createTaskFromPolyline(std::move(polyline));
@@ -129,3 +142,353 @@ TEST_F(ExporterFixture, shouldReimportDocumentWithSameTask)
 	EXPECT_EQ(polyline, firstPathPolyline);
 }
 
+
+TEST_F(ExporterFixture, shouldReimportBinaryDocumentWithSameTask)
+{
+	std::ostringstream output;
+
+	const geometry::Bulge bulge1(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
+	const geometry::Bulge bulge2(geometry::Vector2D(1, 1), geometry::Vector2D(2, 0), 0.5);
+	geometry::Polyline polyline({bulge1, bulge2});
+	const geometry::Polyline expectedPolyline = polyline;
+
+	createTaskFromPolyline(std::move(polyline));
+
+	exporter::dxfplot::Exporter exporter(exporter::dxfplot::Exporter::Format::Binary);
+	exporter(*m_document, output);
+
+	YAML::Node toolsNode;
+	toolsNode["tool"] = YAML::Node();
+
+	YAML::Node profilesNode;
+	profilesNode["profile"] = YAML::Node();
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	std::istringstream input;
+	input.str(output.str());
+	model::Document::UPtr document = importer(input);
+
+	EXPECT_EQ(document->toolConfig().name(), "tool");
+	EXPECT_EQ(document->profileConfig().name(), "profile");
+
+	model::Task &task = document->task();
+	EXPECT_EQ(task.pathCount(), 1);
+
+	// Geometry is decoded on first access only
+	const model::Path &firstPath = task.pathAt(0);
+	EXPECT_FALSE(firstPath.basePolylineLoaded());
+	EXPECT_EQ(task.boundingRect(), expectedPolyline.boundingRect());
+	EXPECT_FALSE(firstPath.isPoint());
+	EXPECT_FALSE(firstPath.basePolylineLoaded());
+
+	const geometry::Polyline &firstPathPolyline = firstPath.basePolyline();
+	EXPECT_TRUE(firstPath.basePolylineLoaded());
+	EXPECT_EQ(expectedPolyline, firstPathPolyline);
+}
+
+TEST_F(ExporterFixture, shouldReimportBinaryDocumentFromMappedFile)
+{
+	geometry::Polyline::List polylines;
+	for (int i = 0; i < 3; ++i) {
+		const geometry::Bulge bulge(geometry::Vector2D(0, i), geometry::Vector2D(i + 1, i), 0.5);
+		polylines.emplace_back(geometry::Bulge::List{bulge});
+	}
+	const geometry::Polyline::List expectedPolylines = polylines;
+
+	createTaskFromPolylines(std::move(polylines));
+
+	const QString fileName = QDir::temp().filePath("dxfplotter-test.dxfplot");
+	{
+		std::ofstream output(fileName.toStdString(), std::ios::binary);
+		exporter::dxfplot::Exporter exporter(exporter::dxfplot::Exporter::Format::Binary);
+		exporter(*m_document, output);
+	}
+
+	YAML::Node toolsNode;
+	toolsNode["tool"] = YAML::Node();
+
+	YAML::Node profilesNode;
+	profilesNode["profile"] = YAML::Node();
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	model::Document::UPtr document = importer(fileName.toStdString());
+
+	const model::Task &task = document->task();
+	ASSERT_EQ(task.layerCount(), 1);
+
+	const model::Layer &layer = task.layerAt(0);
+	ASSERT_EQ(layer.childrenCount(), 3);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_EQ(layer.childrenAt(i).basePolyline(), expectedPolylines[i]);
+	}
+
+	document.reset();
+	QFile::remove(fileName);
+}
+
+TEST_F(ExporterFixture, shouldThrowExceptionWhenBinaryVersionUnsupported)
+{
+	std::ostringstream output;
+	output.write(serializer::BinaryMagic.data(), serializer::BinaryMagic.size());
+
+	{
+		cereal::PortableBinaryOutputArchive archive(output);
+		archive(serializer::BinaryVersion + 1);
+	}
+
+	YAML::Node toolsNode;
+	YAML::Node profilesNode;
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	std::istringstream input;
+	input.str(output.str());
+
+	EXPECT_THROW(importer(input), common::ImportUnsupportedFormatVersionException);
+}
+
+TEST_F(ExporterFixture, shouldLoadVersion1BinaryDocument)
+{
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0.5);
+	geometry::Polyline polyline({bulge});
+	const geometry::Polyline expectedPolyline = polyline;
+
+	createTaskFromPolyline(std::move(polyline));
+
+	// Version 1 stores whole document with polylines in a single archive
+	std::ostringstream output;
+	output.write(serializer::BinaryMagic.data(), serializer::BinaryMagic.size());
+	{
+		cereal::PortableBinaryOutputArchive archive(output);
+		archive(std::uint32_t(1));
+		archive(cereal::make_nvp("task", *m_task));
+		archive(cereal::make_nvp("profile_name", std::string("profile")));
+		archive(cereal::make_nvp("tool_name", std::string("tool")));
+	}
+
+	YAML::Node toolsNode;
+	toolsNode["tool"] = YAML::Node();
+
+	YAML::Node profilesNode;
+	profilesNode["profile"] = YAML::Node();
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	std::istringstream input;
+	input.str(output.str());
+	model::Document::UPtr document = importer(input);
+
+	const model::Task &task = document->task();
+	ASSERT_EQ(task.pathCount(), 1);
+	EXPECT_TRUE(task.pathAt(0).basePolylineLoaded());
+	EXPECT_EQ(task.pathAt(0).basePolyline(), expectedPolyline);
+}
+
+TEST_F(ExporterFixture, shouldLoadVersion2BinaryDocument)
+{
+	const geometry::Bulge bulge1(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
+	const geometry::Bulge bulge2(geometry::Vector2D(1, 1), geometry::Vector2D(2, 0), 0.5);
+	geometry::Polyline polyline({bulge1, bulge2});
+	const geometry::Polyline expectedPolyline = polyline;
+
+	createTaskFromPolyline(std::move(polyline));
+
+	// Version 2 stores base polylines as bulge archives in geometry region
+	std::ostringstream output;
+	output.write(serializer::BinaryMagic.data(), serializer::BinaryMagic.size());
+	{
+		cereal::PortableBinaryOutputArchive archive(output);
+		archive(std::uint32_t(2));
+	}
+
+	serializer::ChunkWriter writer(2);
+	{
+		cereal::UserDataAdapter<serializer::ChunkWriter, cereal::PortableBinaryOutputArchive> archive(writer, output);
+		archive(cereal::make_nvp("task", *m_task));
+		archive(cereal::make_nvp("profile_name", std::string("profile")));
+		archive(cereal::make_nvp("tool_name", std::string("tool")));
+	}
+	const std::string region = writer.region();
+	output.write(region.data(), region.size());
+
+	YAML::Node toolsNode;
+	toolsNode["tool"] = YAML::Node();
+
+	YAML::Node profilesNode;
+	profilesNode["profile"] = YAML::Node();
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	std::istringstream input;
+	input.str(output.str());
+	model::Document::UPtr document = importer(input);
+
+	const model::Task &task = document->task();
+	ASSERT_EQ(task.pathCount(), 1);
+	EXPECT_FALSE(task.pathAt(0).basePolylineLoaded());
+	EXPECT_EQ(task.pathAt(0).basePolyline(), expectedPolyline);
+}
+
+TEST_F(ExporterFixture, shouldThrowExceptionWhenChunkVertexCountCorrupted)
+{
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0.5);
+	const geometry::Polyline polyline({bulge});
+
+	serializer::ChunkWriter writer;
+	const serializer::Chunk chunk = writer.write(polyline);
+	std::string region = writer.region();
+	ASSERT_EQ(chunk.size, region.size());
+
+	serializer::ChunkReader reader(serializer::BinaryVersion);
+	auto loader = reader.loader(chunk);
+	reader.setRegion(serializer::GeometryRegion{nullptr, region.data(), region.size()});
+	EXPECT_EQ(loader(), polyline);
+
+	// One more vertex than stored
+	++region[0];
+	EXPECT_THROW(loader(), common::ImportCorruptedFileException);
+}
+
+TEST_F(ExporterFixture, shouldThrowExceptionWhenGeometryRegionTruncated)
+{
+	geometry::Polyline::List polylines;
+	for (int i = 0; i < 3; ++i) {
+		const geometry::Bulge bulge(geometry::Vector2D(0, i), geometry::Vector2D(i + 1, i), 0);
+		polylines.emplace_back(geometry::Bulge::List{bulge});
+	}
+
+	createTaskFromPolylines(std::move(polylines));
+
+	std::ostringstream output;
+	exporter::dxfplot::Exporter exporter(exporter::dxfplot::Exporter::Format::Binary);
+	exporter(*m_document, output);
+
+	YAML::Node toolsNode;
+	toolsNode["tool"] = YAML::Node();
+
+	YAML::Node profilesNode;
+	profilesNode["profile"] = YAML::Node();
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	// Last chunk ends outside of geometry region
+	const std::string content = output.str();
+	std::istringstream input;
+	input.str(content.substr(0, content.size() - 1));
+
+	EXPECT_THROW(importer(input), common::ImportCorruptedFileException);
+}
+
+TEST_F(ExporterFixture, shouldSnapshotLazyPathsWithoutLoadingThem)
+{
+	geometry::Polyline::List polylines;
+	for (int i = 0; i < 3; ++i) {
+		const geometry::Bulge bulge(geometry::Vector2D(0, i), geometry::Vector2D(i + 1, i), 0.5);
+		polylines.emplace_back(geometry::Bulge::List{bulge});
+	}
+	const geometry::Polyline::List expectedPolylines = polylines;
+
+	createTaskFromPolylines(std::move(polylines));
+	m_task->movePath(0, model::Task::MoveDirection::DOWN);
+
+	std::ostringstream output;
+	exporter::dxfplot::Exporter exporter(exporter::dxfplot::Exporter::Format::Binary);
+	exporter(*m_document, output);
+
+	YAML::Node toolsNode;
+	toolsNode["tool"] = YAML::Node();
+
+	YAML::Node profilesNode;
+	profilesNode["profile"] = YAML::Node();
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	std::istringstream input;
+	input.str(output.str());
+	const model::Document::UPtr document = importer(input);
+
+	const model::DocumentSnapshot snapshot(*document);
+	const model::Document::UPtr restoredDocument = snapshot.restore();
+
+	const model::Task &task = document->task();
+	const model::Task &restoredTask = restoredDocument->task();
+	ASSERT_EQ(restoredTask.pathCount(), 3);
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_FALSE(task.pathAt(i).basePolylineLoaded());
+		EXPECT_FALSE(restoredTask.pathAt(i).basePolylineLoaded());
+	}
+
+	// Stack is restored as is and geometry decoded by restored paths only
+	const int stackIndices[] = {1, 0, 2};
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_EQ(restoredTask.pathAt(i).basePolyline(), expectedPolylines[stackIndices[i]]);
+		EXPECT_FALSE(task.pathAt(i).basePolylineLoaded());
+	}
+}
+
+TEST_F(ExporterFixture, shouldOptimizeStackWithoutLoadingPaths)
+{
+	geometry::Polyline::List polylines;
+	for (int i = 0; i < 5; ++i) {
+		// Alternating directions give a shorter travel once reordered
+		const geometry::Vector2D start((i % 2) ? 10 : 0, i * 5);
+		const geometry::Vector2D end((i % 2) ? 0 : 10, i * 5);
+		polylines.emplace_back(geometry::Bulge::List{geometry::Bulge(start, end, 0)});
+	}
+
+	createTaskFromPolylines(std::move(polylines));
+
+	std::ostringstream output;
+	exporter::dxfplot::Exporter exporter(exporter::dxfplot::Exporter::Format::Binary);
+	exporter(*m_document, output);
+
+	YAML::Node toolsNode;
+	toolsNode["tool"] = YAML::Node();
+
+	YAML::Node profilesNode;
+	profilesNode["profile"] = YAML::Node();
+
+	config::Tools tools{toolsNode};
+	config::Profiles profiles{profilesNode};
+
+	importer::dxfplot::Importer importer(tools, profiles);
+
+	std::istringstream input;
+	input.str(output.str());
+	model::Document::UPtr document = importer(input);
+
+	model::Task &task = document->task();
+	const auto [lazyInitialTravel, lazyOptimizedTravel] = task.optimizeStack(geometry::CuttingDirection::FORWARD, 1.0f, std::chrono::milliseconds(100));
+
+	task.forEachPath([](const model::Path &path){
+		EXPECT_FALSE(path.basePolylineLoaded());
+	});
+
+	// Same travels as loaded paths
+	const auto [initialTravel, optimizedTravel] = m_task->optimizeStack(geometry::CuttingDirection::FORWARD, 1.0f, std::chrono::milliseconds(100));
+	EXPECT_FLOAT_EQ(lazyInitialTravel, initialTravel);
+	EXPECT_FLOAT_EQ(lazyOptimizedTravel, optimizedTravel);
+}
@@ -2,10 +2,18 @@
 
 void ExporterFixture::createTaskFromPolyline(geometry::Polyline &&polyline)
 {
-	model::Path::UPtr path = std::make_unique<model::Path>(std::move(polyline), "", m_settings);
+	geometry::Polyline::List polylines;
+	polylines.push_back(std::move(polyline));
 
+	createTaskFromPolylines(std::move(polylines));
+}
+
+void ExporterFixture::createTaskFromPolylines(geometry::Polyline::List &&polylines)
+{
 	model::Path::ListUPtr paths;
-	paths.push_back(std::move(path));
+	for (geometry::Polyline &polyline : polylines) {
+		paths.push_back(std::make_unique<model::Path>(std::move(polyline), "", m_settings));
+	}
 
 	model::Layer::UPtr layer = std::make_unique<model::Layer>("layer", std::move(paths));
 
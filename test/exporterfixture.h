@@ -16,5 +16,6 @@ protected:
 	std::ostringstream m_output;
 
 	void createTaskFromPolyline(geometry::Polyline &&polyline);
+	void createTaskFromPolylines(geometry::Polyline::List &&polylines);
 };
 
@@ -2,11 +2,13 @@
 
 #include <exporter/gcode/exporter.h>
 
+#include <fmt/format.h>
+
 #include <sstream>
 
 TEST_F(ExporterFixture, shouldRenderAllPathsWhenAllVisible)
 {
-	const geometry::Bulge bulge(QVector2D(0, 0), QVector2D(1, 1), 0);
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
 	geometry::Polyline polyline({bulge});
 
 	createTaskFromPolyline(std::move(polyline));
@@ -29,9 +31,9 @@ G0 X 0.000 Y 0.000
 
 TEST_F(ExporterFixture, shouldRenderOffsetedRightCwTriangleBeCutBackward)
 {
-	const geometry::Bulge b1(QVector2D(0, 0), QVector2D(1, 1), 0);
-	const geometry::Bulge b2(QVector2D(1, 1), QVector2D(1, 0), 0);
-	const geometry::Bulge b3(QVector2D(1, 0), QVector2D(0, 0), 0);
+	const geometry::Bulge b1(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
+	const geometry::Bulge b2(geometry::Vector2D(1, 1), geometry::Vector2D(1, 0), 0);
+	const geometry::Bulge b3(geometry::Vector2D(1, 0), geometry::Vector2D(0, 0), 0);
 	geometry::Polyline polyline({b1, b2, b3});
 
 	ASSERT_TRUE(polyline.isClosed());
@@ -64,9 +66,9 @@ G0 X 0.000 Y 0.000
 
 TEST_F(ExporterFixture, shouldRenderOffsetedLeftCwTriangleBeCutForward)
 {
-	const geometry::Bulge b1(QVector2D(0, 0), QVector2D(1, 1), 0);
-	const geometry::Bulge b2(QVector2D(1, 1), QVector2D(1, 0), 0);
-	const geometry::Bulge b3(QVector2D(1, 0), QVector2D(0, 0), 0);
+	const geometry::Bulge b1(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
+	const geometry::Bulge b2(geometry::Vector2D(1, 1), geometry::Vector2D(1, 0), 0);
+	const geometry::Bulge b3(geometry::Vector2D(1, 0), geometry::Vector2D(0, 0), 0);
 	geometry::Polyline polyline({b1, b2, b3});
 
 	ASSERT_TRUE(polyline.isClosed());
@@ -102,3 +104,71 @@ M5
 G0 X 0.000 Y 0.000
 )", m_output.str());
 }
+
+TEST_F(ExporterFixture, shouldRenderManyPathsInStackOrder)
+{
+	geometry::Polyline::List polylines;
+	for (int i = 1; i <= 3000; ++i) {
+		const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(i % 997, i / 997), 0);
+		polylines.push_back(geometry::Polyline({bulge}));
+	}
+
+	createTaskFromPolylines(std::move(polylines));
+
+	const exporter::gcode::Exporter exporter(m_tool, m_profile);
+	exporter(*m_document, m_output);
+
+	std::ostringstream expected;
+	expected << "G0 Z 1.000\n";
+	m_task->forEachPathInStack([&expected](const model::Path &path){
+		const geometry::Vector2D &end = path.basePolyline().end();
+		expected << "G0 X 0.000 Y 0.000\n"
+			"M4 S 10.000\n"
+			"G1 Z -0.000 F 10.000\n"
+			<< fmt::format("G1 X {:.3f} Y {:.3f} F 10.000\n", end.x(), end.y()) <<
+			"G1 Z -0.100 F 10.000\n"
+			"G1 X 0.000 Y 0.000 F 10.000\n"
+			"G0 Z 1.000\n"
+			"M5\n";
+	});
+	expected << "G0 X 0.000 Y 0.000\n";
+
+	EXPECT_EQ(expected.str(), m_output.str());
+}
+
+TEST_F(ExporterFixture, shouldStartClosedPathNearestToToolWhenOptimizingStartPoint)
+{
+	const geometry::Bulge b1(geometry::Vector2D(4, 4), geometry::Vector2D(2, 4), 0);
+	const geometry::Bulge b2(geometry::Vector2D(2, 4), geometry::Vector2D(2, 2), 0);
+	const geometry::Bulge b3(geometry::Vector2D(2, 2), geometry::Vector2D(4, 2), 0);
+	const geometry::Bulge b4(geometry::Vector2D(4, 2), geometry::Vector2D(4, 4), 0);
+	geometry::Polyline polyline({b1, b2, b3, b4});
+
+	ASSERT_TRUE(polyline.isClosed());
+
+	createTaskFromPolyline(std::move(polyline));
+
+	config::Profiles::Profile profile{"profile", YAML::Node()};
+	profile.cut().optimizeStartPoint() = true;
+
+	const exporter::gcode::Exporter exporter(m_tool, profile);
+	exporter(*m_document, m_output);
+
+	EXPECT_EQ(R"(G0 Z 1.000
+G0 X 2.000 Y 2.000
+M4 S 10.000
+G1 Z -0.000 F 10.000
+G1 X 4.000 Y 2.000 F 10.000
+G1 X 4.000 Y 4.000 F 10.000
+G1 X 2.000 Y 4.000 F 10.000
+G1 X 2.000 Y 2.000 F 10.000
+G1 Z -0.100 F 10.000
+G1 X 4.000 Y 2.000 F 10.000
+G1 X 4.000 Y 4.000 F 10.000
+G1 X 2.000 Y 4.000 F 10.000
+G1 X 2.000 Y 2.000 F 10.000
+G0 Z 1.000
+M5
+G0 X 0.000 Y 0.000
+)", m_output.str());
+}
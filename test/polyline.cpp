@@ -2,10 +2,12 @@
 #include <geometry/polyline.h>
 #include <polylineutils.h>
 
-constexpr QVector2D point1(1.2, 3.4);
-constexpr QVector2D point2(4.5, 6.7);
-constexpr QVector2D point3(7.8, 9.1);
-constexpr QVector2D point4(11.0, 12.0);
+#include <chrono>
+
+constexpr geometry::Vector2D point1(1.2, 3.4);
+constexpr geometry::Vector2D point2(4.5, 6.7);
+constexpr geometry::Vector2D point3(7.8, 9.1);
+constexpr geometry::Vector2D point4(11.0, 12.0);
 
 static const geometry::Bulge pointbulge(point1, point1, 0.0f);
 static const geometry::Bulge bulge1(point1, point2, 0.0f);
@@ -38,6 +40,21 @@ TEST(PolylineTest, WithBulgeAndInvertBulgeIsClosed)
 	EXPECT_FALSE(polyline4.isClosed());
 }
 
+TEST(PolylineTest, WithNearlyJoinedEndsIsClosed)
+{
+	const geometry::Vector2D nearPoint1 = point1 + geometry::Vector2D(1e-12, -1e-12);
+	const geometry::Polyline polyline1({bulge1, geometry::Bulge(point2, nearPoint1, 0.0)});
+	EXPECT_TRUE(polyline1.isClosed());
+
+	const geometry::Vector2D farPoint1 = point1 + geometry::Vector2D(1e-3, 0.0);
+	const geometry::Polyline polyline2({bulge1, geometry::Bulge(point2, farPoint1, 0.0)});
+	EXPECT_FALSE(polyline2.isClosed());
+
+	geometry::Polyline polyline3({bulge1, bulge1next});
+	polyline3.setEnd(point1 + geometry::Vector2D(0.0, 1e-12));
+	EXPECT_TRUE(polyline3.isClosed());
+}
+
 TEST(PolylineTest, ClosedPolylineHasStartEqualsToEnd)
 {
 	const geometry::Polyline polyline1({bulge1, bulge1invert});
@@ -108,7 +125,7 @@ TEST(PolylineTest, ScaleTransformIterateBulgeScaled)
 
 TEST(PolylineTest, TestLinePolylineOffsetedHasMovedStartEnd)
 {
-	const geometry::Bulge bulge(QVector2D(0.0f, 3.4f), QVector2D(5.0f, 3.4f), 0.0f);
+	const geometry::Bulge bulge(geometry::Vector2D(0.0f, 3.4f), geometry::Vector2D(5.0f, 3.4f), 0.0f);
 	const geometry::Polyline polyline({bulge});
 
 	const float offset = 1.2f;
@@ -125,7 +142,7 @@ TEST(PolylineTest, TestLinePolylineOffsetedHasMovedStartEnd)
 
 TEST(PolylineTest, TestPointPolylineOffsetedIsPoint)
 {
-	const geometry::Bulge bulge(QVector2D(0.0f, 3.4f), QVector2D(0.0f, 3.4f), 0.0f);
+	const geometry::Bulge bulge(geometry::Vector2D(0.0f, 3.4f), geometry::Vector2D(0.0f, 3.4f), 0.0f);
 	const geometry::Polyline polyline({bulge});
 
 	const float offset = 1.2f;
@@ -162,3 +179,252 @@ TEST(PolylineTest, TestConcavePolylineOrientation)
 	const geometry::Polyline invertedPolyline = polyline.inverse();
 	ASSERT_EQ(invertedPolyline.orientation(), geometry::Orientation::CW);
 }
+
+TEST(PolylineTest, RotateToClosestStartSplitsClosestBulge)
+{
+	const geometry::Vector2D corners[] = {geometry::Vector2D(0.0f, 0.0f), geometry::Vector2D(4.0f, 0.0f), geometry::Vector2D(4.0f, 4.0f), geometry::Vector2D(0.0f, 4.0f)};
+	geometry::Polyline polyline({
+		geometry::Bulge(corners[2], corners[3], 0.0f),
+		geometry::Bulge(corners[3], corners[0], 0.0f),
+		geometry::Bulge(corners[0], corners[1], 0.0f),
+		geometry::Bulge(corners[1], corners[2], 0.0f)
+	});
+	const float length = polyline.length();
+
+	polyline.rotateToClosestStart(geometry::Vector2D(2.0f, -1.0f));
+
+	EXPECT_NEAR(polyline.start().x(), 2.0f, 1e-5f);
+	EXPECT_NEAR(polyline.start().y(), 0.0f, 1e-5f);
+	EXPECT_TRUE(polyline.isClosed());
+	EXPECT_FLOAT_EQ(polyline.length(), length);
+}
+
+TEST(PolylineTest, RotateToClosestStartOnVertexDoesNotSplit)
+{
+	geometry::Polyline polyline({
+		geometry::Bulge(point1, point2, 0.0f),
+		geometry::Bulge(point2, point3, 0.0f),
+		geometry::Bulge(point3, point1, 0.0f)
+	});
+
+	polyline.rotateToClosestStart(point3);
+
+	EXPECT_EQ(polyline.start(), point3);
+	EXPECT_EQ(polyline.end(), point3);
+
+	int nbBulges = 0;
+	polyline.forEachBulge([&nbBulges](const geometry::Bulge &){ ++nbBulges; });
+	EXPECT_EQ(nbBulges, 3);
+}
+
+TEST(PolylineTest, RotateToClosestStartOnStartKeepsCaches)
+{
+	geometry::Polyline polyline({
+		geometry::Bulge(point1, point2, 0.5f),
+		geometry::Bulge(point2, point3, 0.0f),
+		geometry::Bulge(point3, point1, 0.0f)
+	});
+	const std::shared_ptr<const geometry::Polyline::ArcList> arcs = polyline.arcs();
+
+	polyline.rotateToClosestStart(point1);
+
+	EXPECT_EQ(polyline.start(), point1);
+	EXPECT_EQ(polyline.arcs(), arcs);
+}
+
+TEST(PolylineTest, BoundingRectIncludesArcExtremes)
+{
+	const geometry::Vector2D left(-1.0f, 0.0f);
+	const geometry::Vector2D right(1.0f, 0.0f);
+	// Half circle going through bottom
+	const geometry::Polyline polyline({geometry::Bulge(left, right, 1.0f)});
+
+	const geometry::Rect rect = polyline.boundingRect();
+	EXPECT_FLOAT_EQ(rect.min().x(), -1.0f);
+	EXPECT_NEAR(rect.min().y(), -1.0f, 1e-5f);
+	EXPECT_FLOAT_EQ(rect.max().x(), 1.0f);
+	EXPECT_NEAR(rect.max().y(), 0.0f, 1e-5f);
+}
+
+TEST(PolylineTest, ContainsPointInsideArcs)
+{
+	const geometry::Vector2D left(-1.0f, 0.0f);
+	const geometry::Vector2D right(1.0f, 0.0f);
+	const geometry::Polyline circle({geometry::Bulge(left, right, 1.0f), geometry::Bulge(right, left, 1.0f)});
+
+	EXPECT_TRUE(circle.contains(geometry::Vector2D(0.0f, 0.0f)));
+	EXPECT_TRUE(circle.contains(geometry::Vector2D(0.5f, 0.5f)));
+	EXPECT_TRUE(circle.contains(geometry::Vector2D(-0.9f, 0.0f)));
+	EXPECT_FALSE(circle.contains(geometry::Vector2D(0.8f, 0.8f)));
+	EXPECT_FALSE(circle.contains(geometry::Vector2D(-2.0f, 0.0f)));
+	EXPECT_FALSE(circle.contains(geometry::Vector2D(0.0f, 1.0f)));
+
+	const geometry::Polyline concave = createStartPolyline(5.0f, 10.0f, 10);
+	EXPECT_TRUE(concave.contains(geometry::Vector2D(0.0f, 0.0f)));
+	EXPECT_FALSE(concave.contains(geometry::Vector2D(11.0f, 0.0f)));
+}
+
+TEST(PolylineTest, InverseKeepsArcsOnReversedBulges)
+{
+	const geometry::Bulge arc(point2, point3, 0.5f);
+	const geometry::Polyline polyline({bulge1, arc, bulge2});
+
+	geometry::Bulge::List expectedBulges{bulge2, arc, bulge1};
+	for (geometry::Bulge &bulge : expectedBulges) {
+		bulge.invert();
+	}
+
+	EXPECT_EQ(polyline.inverse().bulges(), expectedBulges);
+	EXPECT_EQ(polyline.inverse().inverse(), polyline);
+}
+
+TEST(PolylineTest, MirrorTransformInvertsArcs)
+{
+	geometry::Polyline polyline({geometry::Bulge(point1, point2, 0.5f), geometry::Bulge(point2, point3, -0.25f)});
+
+	polyline.transform(geometry::Transform::FromScale(-1.0, 1.0));
+
+	const geometry::Bulge::List bulges = polyline.bulges();
+	ASSERT_EQ(bulges.size(), 2);
+	EXPECT_FLOAT_EQ(bulges[0].tangent(), -0.5f);
+	EXPECT_FLOAT_EQ(bulges[1].tangent(), 0.25f);
+	EXPECT_FLOAT_EQ(bulges[0].end().x(), -point2.x());
+	EXPECT_EQ(bulges[0].end(), bulges[1].start());
+}
+
+TEST(PolylineTest, DefaultConstructedIsModifiable)
+{
+	geometry::Polyline polyline;
+	polyline.transform(geometry::Transform::FromScale(2.0, 2.0));
+	EXPECT_EQ(polyline.bulgeCount(), 0);
+
+	geometry::Polyline inverted;
+	inverted.invert();
+	inverted.transform(geometry::Transform::FromScale(-1.0, 1.0));
+	EXPECT_EQ(inverted.bulgeCount(), 0);
+}
+
+TEST(PolylineTest, CachedArcsMatchBulgeArcs)
+{
+	const geometry::Polyline polyline({geometry::Bulge(point1, point2, 0.5f), bulge1next, geometry::Bulge(point3, point4, -0.75f)});
+
+	const std::shared_ptr<const geometry::Polyline::ArcList> arcs = polyline.arcs();
+	ASSERT_EQ(arcs->size(), 3);
+	EXPECT_FALSE((*arcs)[1]);
+
+	const geometry::Bulge::List bulges = polyline.bulges();
+	for (const int index : {0, 2}) {
+		ASSERT_TRUE((*arcs)[index]);
+		const geometry::Arc &arc = *(*arcs)[index];
+		const geometry::Arc reference = bulges[index].toArc();
+		EXPECT_NEAR(arc.center().x(), reference.center().x(), 1e-4);
+		EXPECT_NEAR(arc.center().y(), reference.center().y(), 1e-4);
+		EXPECT_NEAR(arc.radius(), reference.radius(), 1e-4);
+		EXPECT_EQ(arc.orientation(), reference.orientation());
+	}
+
+	// Cache is shared by next calls
+	EXPECT_EQ(polyline.arcs(), arcs);
+}
+
+TEST(PolylineTest, CachedArcsInvalidatedByTransformAndInvert)
+{
+	geometry::Polyline polyline({geometry::Bulge(point1, point2, 0.5f)});
+	const geometry::Vector2D center = polyline.arcs()->front()->center();
+
+	polyline.transform(geometry::Transform::FromTranslate(1.0, 2.0));
+	const geometry::Vector2D translatedCenter = polyline.arcs()->front()->center();
+	EXPECT_NEAR(translatedCenter.x(), center.x() + 1.0, 1e-4);
+	EXPECT_NEAR(translatedCenter.y(), center.y() + 2.0, 1e-4);
+
+	polyline.invert();
+	const geometry::Arc &invertedArc = *polyline.arcs()->front();
+	EXPECT_EQ(invertedArc.orientation(), geometry::Orientation::CW);
+	EXPECT_EQ(invertedArc.start(), polyline.start());
+}
+
+/// Timing of cached arcs, run on demand with --gtest_also_run_disabled_tests
+TEST(PolylineTest, DISABLED_BenchmarkCachedArcs)
+{
+	constexpr int nbBulges = 100000;
+	// Depth passes of an export
+	constexpr int nbPasses = 10;
+
+	geometry::Bulge::List bulges;
+	for (int i = 0; i < nbBulges; ++i) {
+		bulges.emplace_back(geometry::Vector2D(i, 0), geometry::Vector2D(i + 1, 0), (i % 2) ? 0.5f : -0.5f);
+	}
+	const geometry::Polyline polyline(bulges);
+
+	double uncachedRadius = 0.0;
+	const auto uncachedStart = std::chrono::steady_clock::now();
+	for (int pass = 0; pass < nbPasses; ++pass) {
+		polyline.forEachBulge([&uncachedRadius](const geometry::Bulge &bulge){
+			uncachedRadius += bulge.toArc().radius();
+		});
+	}
+	const auto uncachedEnd = std::chrono::steady_clock::now();
+
+	double cachedRadius = 0.0;
+	const auto cachedStart = std::chrono::steady_clock::now();
+	for (int pass = 0; pass < nbPasses; ++pass) {
+		polyline.forEachBulgeWithArc([&cachedRadius](const geometry::Bulge &, const std::optional<geometry::Arc> &arc){
+			cachedRadius += arc->radius();
+		});
+	}
+	const auto cachedEnd = std::chrono::steady_clock::now();
+
+	EXPECT_NEAR(cachedRadius, uncachedRadius, uncachedRadius * 1e-6);
+
+	RecordProperty("uncached_milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(uncachedEnd - uncachedStart).count());
+	RecordProperty("cached_milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(cachedEnd - cachedStart).count());
+}
+
+TEST(PolylineTest, CachedBoundingRectInvalidatedByTransform)
+{
+	geometry::Polyline polyline({geometry::Bulge(geometry::Vector2D(0.0, 0.0), geometry::Vector2D(2.0, 0.0), 1.0f)});
+	const geometry::Rect rect = polyline.boundingRect();
+	EXPECT_NEAR(rect.min().y(), -1.0, 1e-5);
+
+	polyline.transform(geometry::Transform::FromTranslate(1.0, 2.0));
+	const geometry::Rect translatedRect = polyline.boundingRect();
+	EXPECT_NEAR(translatedRect.min().x(), 1.0, 1e-5);
+	EXPECT_NEAR(translatedRect.min().y(), 1.0, 1e-5);
+	EXPECT_NEAR(translatedRect.max().x(), 3.0, 1e-5);
+	EXPECT_NEAR(translatedRect.max().y(), 2.0, 1e-5);
+}
+
+TEST(PolylineTest, ModifyingCopyKeepsOriginal)
+{
+	const geometry::Polyline polyline({bulge1, bulge1next});
+	geometry::Polyline copy = polyline;
+	EXPECT_EQ(copy, polyline);
+
+	copy.transform(geometry::Transform::FromTranslate(1.0, 2.0));
+	copy.setEnd(point4);
+
+	EXPECT_EQ(polyline.start(), point1);
+	EXPECT_EQ(polyline.end(), point3);
+	EXPECT_EQ(copy.start(), point1 + geometry::Vector2D(1.0, 2.0));
+	EXPECT_EQ(copy.end(), point4);
+}
+
+TEST(PolylineTest, ModifyingInverseMatchesInvertedBulges)
+{
+	const geometry::Bulge arc(point2, point3, 0.5f);
+	const geometry::Polyline polyline({bulge1, arc});
+
+	geometry::Bulge::List invertedBulges{arc, bulge1};
+	for (geometry::Bulge &bulge : invertedBulges) {
+		bulge.invert();
+	}
+	const geometry::Polyline inverted(invertedBulges);
+
+	geometry::Polyline inverse = polyline.inverse();
+	EXPECT_EQ(inverse, inverted);
+
+	inverse += geometry::Polyline({geometry::Bulge(point1, point4, 0.0f)});
+	invertedBulges.emplace_back(point1, point4, 0.0f);
+	EXPECT_EQ(inverse.bulges(), invertedBulges);
+	EXPECT_EQ(polyline.bulges(), geometry::Bulge::List({bulge1, arc}));
+}
@@ -6,12 +6,12 @@ geometry::Polyline createStartPolyline(float innerRadius, float outterRadius, in
 
 	for (int i = 0, max = nbBranches * 2; i < max; i += 2) {
 		const float angle = M_PI * i / nbBranches;
-		points[i] = QVector2D(std::cos(angle), std::sin(angle)) * outterRadius;
+		points[i] = geometry::Vector2D(std::cos(angle), std::sin(angle)) * outterRadius;
 	}
 
 	for (int i = 1, max = nbBranches * 2; i < max; i += 2) {
 		const float angle = M_PI * i / nbBranches;
-		points[i] = QVector2D(std::cos(angle), std::sin(angle)) * innerRadius;
+		points[i] = geometry::Vector2D(std::cos(angle), std::sin(angle)) * innerRadius;
 	}
 
 	geometry::Bulge::List bulges(points.size());
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <geometry/rtree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+static geometry::Rect::List randomRects(int count)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+	std::uniform_real_distribution<float> size(0.0f, 20.0f);
+
+	geometry::Rect::List rects;
+	for (int i = 0; i < count; ++i) {
+		const geometry::Vector2D corner(position(generator), position(generator));
+		rects.emplace_back(corner, corner + geometry::Vector2D(size(generator), size(generator)));
+	}
+
+	return rects;
+}
+
+TEST(RTreeTest, shouldFindSameRectsAsLinearSearch)
+{
+	const geometry::Rect::List rects = randomRects(5000);
+	const geometry::RTree tree(rects);
+
+	ASSERT_EQ(tree.size(), 5000);
+
+	const geometry::Rect::List windows = randomRects(100);
+	for (const geometry::Rect &window : windows) {
+		std::vector<int> expected;
+		for (int index = 0, size = rects.size(); index < size; ++index) {
+			if (rects[index].intersects(window)) {
+				expected.push_back(index);
+			}
+		}
+
+		std::vector<int> found = tree.intersecting(window);
+		std::sort(found.begin(), found.end());
+
+		EXPECT_EQ(found, expected);
+	}
+}
+
+TEST(RTreeTest, shouldBoundAllRects)
+{
+	const geometry::Rect::List rects = randomRects(100);
+	const geometry::RTree tree(rects);
+
+	geometry::Rect boundingRect;
+	for (const geometry::Rect &rect : rects) {
+		boundingRect |= rect;
+	}
+
+	EXPECT_EQ(tree.boundingRect(), boundingRect);
+	EXPECT_TRUE(geometry::RTree().intersecting(boundingRect).empty());
+}
+
+TEST(RTreeTest, shouldFindSameRectsAsLinearSearchAfterUpdates)
+{
+	geometry::Rect::List rects = randomRects(2000);
+	// Start from half of the rects, insert others one by one
+	geometry::RTree tree(geometry::Rect::List(rects.begin(), rects.begin() + 1000));
+	for (int index = 1000; index < 2000; ++index) {
+		tree.insert(index, rects[index]);
+	}
+
+	// Move some rects and remove others
+	const geometry::Rect::List moved = randomRects(500);
+	std::vector<bool> present(rects.size(), true);
+	for (int index = 0; index < 500; ++index) {
+		tree.update(index * 4, moved[index]);
+		rects[index * 4] = moved[index];
+		tree.remove(index * 4 + 1);
+		present[index * 4 + 1] = false;
+	}
+
+	ASSERT_EQ(tree.size(), 1500);
+
+	const geometry::Rect::List windows = randomRects(100);
+	for (const geometry::Rect &window : windows) {
+		std::vector<int> expected;
+		for (int index = 0, size = rects.size(); index < size; ++index) {
+			if (present[index] && rects[index].intersects(window)) {
+				expected.push_back(index);
+			}
+		}
+
+		std::vector<int> found = tree.intersecting(window);
+		std::sort(found.begin(), found.end());
+
+		EXPECT_EQ(found, expected);
+	}
+}
+
+TEST(RTreeTest, shouldFindNearestRect)
+{
+	const geometry::Rect::List rects = randomRects(3000);
+	const geometry::RTree tree(rects);
+
+	const auto rectDistance = [](const geometry::Rect &rect, const geometry::Vector2D &point){
+		const double dx = std::max({rect.min().x() - point.x(), 0.0, point.x() - rect.max().x()});
+		const double dy = std::max({rect.min().y() - point.y(), 0.0, point.y() - rect.max().y()});
+		return std::sqrt(dx * dx + dy * dy);
+	};
+
+	for (const geometry::Rect &query : randomRects(50)) {
+		const geometry::Vector2D &point = query.min();
+
+		double expectedDistance = std::numeric_limits<double>::max();
+		for (const geometry::Rect &rect : rects) {
+			expectedDistance = std::min(expectedDistance, rectDistance(rect, point));
+		}
+
+		const int found = tree.nearest(point, [&rects, &point, &rectDistance](int index){
+			return rectDistance(rects[index], point);
+		});
+
+		ASSERT_NE(found, -1);
+		EXPECT_DOUBLE_EQ(rectDistance(rects[found], point), expectedDistance);
+	}
+
+	// Nothing closer than max distance
+	EXPECT_EQ(tree.nearest(geometry::Vector2D(-100.0, -100.0), [](int){ return 0.0; }, 10.0), -1);
+}
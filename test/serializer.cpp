@@ -2,14 +2,21 @@
 
 #include <cereal/cereal.hpp>
 #include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
 
 #include <serializer/bulge.h>
 
+#include <exporter/dxfplot/exporter.h>
+#include <importer/dxfplot/importer.h>
+
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <string>
 
 TEST(Serializer, shouldSerializeVectorWithNoDataLoose)
 {
-	const QVector2D point(1, 42);
+	const geometry::Vector2D point(1, 42);
 
 	std::ostringstream output;
 
@@ -23,7 +30,7 @@ TEST(Serializer, shouldSerializeVectorWithNoDataLoose)
 
 	{
 		cereal::JSONInputArchive archive(input);
-		QVector2D outPoint;
+		geometry::Vector2D outPoint;
 		archive(outPoint);
 
 		EXPECT_EQ(point, outPoint);
@@ -32,7 +39,7 @@ TEST(Serializer, shouldSerializeVectorWithNoDataLoose)
 
 TEST(Serializer, shouldSerializeBulgeWithNoDataLoose)
 {
-	const geometry::Bulge bulge(QVector2D(0, 0), QVector2D(1, 1), 0);
+	const geometry::Bulge bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0);
 
 	std::ostringstream output;
 
@@ -53,3 +60,128 @@ TEST(Serializer, shouldSerializeBulgeWithNoDataLoose)
 	}
 }
 
+TEST(Serializer, shouldLoadFloatTangentOfVersion0Bulge)
+{
+	std::ostringstream output;
+
+	{
+		// Bulge version 0 followed by point version 0 and float tangent
+		cereal::PortableBinaryOutputArchive archive(output);
+		archive(std::uint32_t(0), std::uint32_t(0), 0.0, 0.0, 1.0, 1.0, 0.5f);
+	}
+
+	std::istringstream input;
+	input.str(output.str());
+
+	{
+		cereal::PortableBinaryInputArchive archive(input);
+		geometry::Bulge outBulge;
+		archive(outBulge);
+
+		EXPECT_EQ(geometry::Bulge(geometry::Vector2D(0, 0), geometry::Vector2D(1, 1), 0.5), outBulge);
+	}
+}
+
+
+/// Binary save and load of tasks with many paths
+class SerializerTiming : public ExporterFixture
+{
+protected:
+	const YAML::Node m_toolsNode = createNode("tool");
+	const YAML::Node m_profilesNode = createNode("profile");
+	const config::Tools m_tools{m_toolsNode};
+	const config::Profiles m_profiles{m_profilesNode};
+	/// Bounding rectangles of paths in stack order before saving
+	std::vector<geometry::Rect> m_stackRects;
+
+	static YAML::Node createNode(const std::string &name)
+	{
+		YAML::Node node;
+		node[name] = YAML::Node();
+		return node;
+	}
+
+	void createShuffledTask(int nbPaths)
+	{
+		// Shuffled lengths to get a stack order different from paths order
+		geometry::Polyline::List polylines;
+		polylines.reserve(nbPaths);
+		for (int i = 0; i < nbPaths; ++i) {
+			const double length = (i * 7919) % nbPaths + 1;
+			polylines.emplace_back(geometry::Bulge::List{geometry::Bulge(geometry::Vector2D(0, i), geometry::Vector2D(length, i), 0)});
+		}
+
+		createTaskFromPolylines(std::move(polylines));
+
+		m_stackRects.clear();
+		m_stackRects.reserve(nbPaths);
+		m_task->forEachPathInStack([this](const model::Path &path){
+			m_stackRects.push_back(path.boundingRect());
+		});
+	}
+
+	std::string saveBinary() const
+	{
+		std::ostringstream output;
+		exporter::dxfplot::Exporter exporter(exporter::dxfplot::Exporter::Format::Binary);
+		exporter(*m_document, output);
+
+		return output.str();
+	}
+
+	model::Document::UPtr loadBinary(const std::string &content) const
+	{
+		importer::dxfplot::Importer importer(m_tools, m_profiles);
+
+		std::istringstream input;
+		input.str(content);
+		return importer(input);
+	}
+
+	void expectStackRestored(const model::Task &task) const
+	{
+		ASSERT_EQ(task.pathCount(), (int)m_stackRects.size());
+		int nbMisplacedPaths = 0;
+		for (int i = 0, size = m_stackRects.size(); i < size; ++i) {
+			nbMisplacedPaths += !(task.pathAt(i).boundingRect() == m_stackRects[i]);
+		}
+		EXPECT_EQ(nbMisplacedPaths, 0);
+	}
+};
+
+class SerializerBenchmark : public SerializerTiming, public ::testing::WithParamInterface<int>
+{
+};
+
+TEST_F(SerializerTiming, shouldRestoreStackOfLargeShuffledTask)
+{
+	createShuffledTask(100000);
+	const std::string content = saveBinary();
+
+	m_document.reset();
+
+	expectStackRestored(loadBinary(content)->task());
+}
+
+/// Timings of save and load, run on demand with --gtest_also_run_disabled_tests
+TEST_P(SerializerBenchmark, DISABLED_shouldSaveAndLoadHugeTask)
+{
+	createShuffledTask(GetParam());
+
+	const auto saveStart = std::chrono::steady_clock::now();
+	const std::string content = saveBinary();
+	const auto saveEnd = std::chrono::steady_clock::now();
+
+	m_document.reset();
+
+	const auto loadStart = std::chrono::steady_clock::now();
+	const model::Document::UPtr document = loadBinary(content);
+	const auto loadEnd = std::chrono::steady_clock::now();
+
+	expectStackRestored(document->task());
+
+	RecordProperty("save_milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(saveEnd - saveStart).count());
+	RecordProperty("load_milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(loadEnd - loadStart).count());
+}
+
+INSTANTIATE_TEST_SUITE_P(PathCounts, SerializerBenchmark, ::testing::Values(10000, 100000, 1000000));
@@ -0,0 +1,270 @@
+#include <exporterfixture.h>
+
+#include <model/snapshot.h>
+#include <model/passes.h>
+
+static geometry::Polyline::List createLines(int count)
+{
+	geometry::Polyline::List polylines;
+	for (int i = 0; i < count; ++i) {
+		// Increasing lengths give stack in creation order
+		const geometry::Bulge bulge(geometry::Vector2D(0, i), geometry::Vector2D(i + 1, i), 0);
+		polylines.emplace_back(geometry::Bulge::List{bulge});
+	}
+
+	return polylines;
+}
+
+static void expectIndicesMatchPositions(const model::Task &task)
+{
+	for (int index = 0, size = task.pathCount(); index < size; ++index) {
+		const model::Path &path = task.pathAt(index);
+		EXPECT_EQ(task.pathIndexFor(path), index);
+
+		const std::pair<int, int> indices = task.layerAndPathIndexFor(path);
+		EXPECT_EQ(&task.layerAt(indices.first).childrenAt(indices.second), &path);
+	}
+
+	for (int index = 0, size = task.layerCount(); index < size; ++index) {
+		EXPECT_EQ(task.layerIndexFor(task.layerAt(index)), index);
+	}
+}
+
+TEST_F(ExporterFixture, shouldFindPathIndicesAfterMove)
+{
+	createTaskFromPolylines(createLines(5));
+
+	expectIndicesMatchPositions(*m_task);
+
+	const model::Path &path = m_task->pathAt(1);
+	m_task->movePath(1, model::Task::MoveDirection::DOWN);
+	m_task->movePath(2, model::Task::MoveDirection::DOWN);
+	m_task->movePath(0, model::Task::MoveDirection::UP);
+
+	EXPECT_EQ(m_task->pathIndexFor(path), 3);
+	expectIndicesMatchPositions(*m_task);
+}
+
+TEST_F(ExporterFixture, shouldRestoreSnapshotAsDetachedDocument)
+{
+	createTaskFromPolylines(createLines(3));
+
+	m_task->movePath(0, model::Task::MoveDirection::DOWN);
+	m_task->pathAt(1).setVisible(false);
+	m_task->pathAt(2).offset(0.1f, 0.0f, 0.0f);
+
+	const model::DocumentSnapshot snapshot(*m_document);
+
+	// Document edited after snapshot is not affected
+	m_task->pathAt(0).setVisible(false);
+
+	const model::Document::UPtr document = snapshot.restore();
+	const model::Task &task = document->task();
+
+	ASSERT_EQ(task.pathCount(), 3);
+	EXPECT_EQ(task.pathAt(0).basePolyline(), m_task->pathAt(0).basePolyline());
+	EXPECT_EQ(task.pathAt(1).basePolyline(), m_task->pathAt(1).basePolyline());
+	EXPECT_TRUE(task.pathAt(0).visible());
+	EXPECT_FALSE(task.pathAt(1).visible());
+	ASSERT_NE(task.pathAt(2).offsettedPath(), nullptr);
+	EXPECT_EQ(task.pathAt(2).offsettedPath()->polylines(), m_task->pathAt(2).offsettedPath()->polylines());
+	EXPECT_EQ(&document->toolConfig(), &m_document->toolConfig());
+}
+
+static geometry::Polyline createLine(const geometry::Vector2D &start, const geometry::Vector2D &end)
+{
+	return geometry::Polyline({geometry::Bulge(start, end, 0)});
+}
+
+TEST_F(ExporterFixture, shouldOptimizeStackOnCutEntryAndExit)
+{
+	geometry::Polyline::List polylines;
+	polylines.push_back(createLine(geometry::Vector2D(1, 0), geometry::Vector2D(10, 0)));
+	polylines.push_back(createLine(geometry::Vector2D(20, 0), geometry::Vector2D(30, 0)));
+	createTaskFromPolylines(std::move(polylines));
+
+	// First path is cut backward from its end
+	model::Path &backwardPath = m_task->pathAt(0);
+	backwardPath.setOffsettedPolylines({{backwardPath.basePolyline()}, model::OffsettedPath::Direction::RIGHT});
+
+	const geometry::CuttingDirection direction = m_profile.cut().direction();
+	const float depthPerCut = m_tool.general().depthPerCut();
+
+	const model::Passes backwardPasses(backwardPath, direction, depthPerCut);
+	EXPECT_EQ(backwardPasses.direction(), geometry::CuttingDirection::BACKWARD);
+	// Open paths cut in an even number of passes are left where they are entered
+	ASSERT_EQ(backwardPasses.count() % 2, 0);
+	EXPECT_EQ(backwardPasses.entry(backwardPath.basePolyline()), geometry::Vector2D(10, 0));
+	EXPECT_EQ(backwardPasses.exit(backwardPath.basePolyline()), geometry::Vector2D(10, 0));
+
+	const model::Path &forwardPath = m_task->pathAt(1);
+	const model::Passes forwardPasses(forwardPath, direction, depthPerCut);
+	EXPECT_EQ(forwardPasses.exit(forwardPath.basePolyline()), geometry::Vector2D(20, 0));
+
+	// Every order travels from origin to 10, back to 20 and origin
+	const auto [initialTravel, optimizedTravel] = m_task->optimizeStack(direction, depthPerCut, std::chrono::milliseconds(100));
+	EXPECT_FLOAT_EQ(initialTravel, 40.0f);
+	EXPECT_FLOAT_EQ(optimizedTravel, 40.0f);
+}
+
+static geometry::Polyline createSquare(float x, float y, float size)
+{
+	const geometry::Vector2D p1(x, y);
+	const geometry::Vector2D p2(x + size, y);
+	const geometry::Vector2D p3(x + size, y + size);
+	const geometry::Vector2D p4(x, y + size);
+
+	return geometry::Polyline({
+		geometry::Bulge(p1, p2, 0.0f),
+		geometry::Bulge(p2, p3, 0.0f),
+		geometry::Bulge(p3, p4, 0.0f),
+		geometry::Bulge(p4, p1, 0.0f)
+	});
+}
+
+/// Expect pocket vertices between island and border squares centered on (50, 50)
+static void expectPocketBetween(const model::Path &path, float islandHalfSize, float borderHalfSize, float radius)
+{
+	ASSERT_NE(path.offsettedPath(), nullptr);
+	const geometry::Polyline::List &polylines = path.offsettedPath()->polylines();
+	ASSERT_FALSE(polylines.empty());
+
+	constexpr float tolerance = 1e-3f;
+	const geometry::Vector2D center(50, 50);
+	for (const geometry::Polyline &polyline : polylines) {
+		polyline.forEachBulge([&](const geometry::Bulge &bulge){
+			const geometry::Vector2D relative = bulge.start() - center;
+			const float distance = std::max(std::abs(relative.x()), std::abs(relative.y()));
+			EXPECT_GE(distance, islandHalfSize + radius - tolerance);
+			EXPECT_LE(distance, borderHalfSize - radius + tolerance);
+		});
+	}
+}
+
+TEST_F(ExporterFixture, shouldPocketNestedBordersAroundIslands)
+{
+	geometry::Polyline::List polylines;
+	polylines.push_back(createSquare(0, 0, 100)); // Outer border
+	polylines.push_back(createSquare(10, 10, 80)); // Island of outer border
+	polylines.push_back(createSquare(30, 30, 40)); // Border inside island
+	polylines.push_back(createSquare(40, 40, 20)); // Island of inner border
+	createTaskFromPolylines(std::move(polylines));
+
+	constexpr float radius = 1.0f;
+	EXPECT_EQ(m_task->pocketAll(radius, 0.01f, 0.01f), 2);
+
+	expectPocketBetween(m_task->pathAt(0), 40, 50, radius);
+	expectPocketBetween(m_task->pathAt(2), 10, 20, radius);
+	EXPECT_EQ(m_task->pathAt(1).offsettedPath(), nullptr);
+	EXPECT_EQ(m_task->pathAt(3).offsettedPath(), nullptr);
+}
+
+/// Record selection signals of a task
+struct SelectionRecorder
+{
+	std::vector<std::pair<model::Path::ListPtr, bool>> pathsChanges;
+	int pathChangeCount = 0;
+	std::vector<int> sizes;
+
+	explicit SelectionRecorder(model::Task &task)
+	{
+		QObject::connect(&task, &model::Task::pathsSelectedChanged, [this](const model::Path::ListPtr &paths, bool selected){
+			pathsChanges.emplace_back(paths, selected);
+		});
+		QObject::connect(&task, &model::Task::pathSelectedChanged, [this](){
+			++pathChangeCount;
+		});
+		QObject::connect(&task, &model::Task::selectionChanged, [this](int size){
+			sizes.push_back(size);
+		});
+	}
+};
+
+TEST_F(ExporterFixture, shouldNotifySelectAllOnce)
+{
+	createTaskFromPolylines(createLines(4));
+	m_task->pathAt(0).setSelected(true);
+
+	SelectionRecorder recorder(*m_task);
+	m_task->selectAll();
+
+	// Already selected path is not notified
+	ASSERT_EQ(recorder.pathsChanges.size(), 1);
+	EXPECT_EQ(recorder.pathsChanges[0].first, model::Path::ListPtr({&m_task->pathAt(1), &m_task->pathAt(2), &m_task->pathAt(3)}));
+	EXPECT_TRUE(recorder.pathsChanges[0].second);
+	EXPECT_EQ(recorder.pathChangeCount, 0);
+	EXPECT_EQ(recorder.sizes, std::vector<int>({4}));
+
+	// Nothing changes
+	m_task->selectAll();
+	EXPECT_EQ(recorder.pathsChanges.size(), 1);
+	EXPECT_EQ(recorder.sizes.size(), 1);
+}
+
+TEST_F(ExporterFixture, shouldNotifyInvertSelectionOnce)
+{
+	createTaskFromPolylines(createLines(3));
+	m_task->pathAt(1).setSelected(true);
+
+	SelectionRecorder recorder(*m_task);
+	m_task->invertSelection();
+
+	ASSERT_EQ(recorder.pathsChanges.size(), 2);
+	EXPECT_EQ(recorder.pathsChanges[0].first, model::Path::ListPtr({&m_task->pathAt(1)}));
+	EXPECT_FALSE(recorder.pathsChanges[0].second);
+	EXPECT_EQ(recorder.pathsChanges[1].first, model::Path::ListPtr({&m_task->pathAt(0), &m_task->pathAt(2)}));
+	EXPECT_TRUE(recorder.pathsChanges[1].second);
+	EXPECT_EQ(recorder.pathChangeCount, 0);
+	EXPECT_EQ(recorder.sizes, std::vector<int>({2}));
+}
+
+TEST_F(ExporterFixture, shouldNotifyOnlyChangedPathsOfSelectArea)
+{
+	createTaskFromPolylines(createLines(3));
+	m_task->pathAt(0).setSelected(true);
+	m_task->pathAt(1).setSelected(true);
+
+	SelectionRecorder recorder(*m_task);
+	// Path 1 is deselected then selected again by window
+	m_task->selectArea(geometry::Rect(geometry::Vector2D(-1, 0.5), geometry::Vector2D(10, 2.5)), false);
+
+	ASSERT_EQ(recorder.pathsChanges.size(), 2);
+	EXPECT_EQ(recorder.pathsChanges[0].first, model::Path::ListPtr({&m_task->pathAt(0)}));
+	EXPECT_FALSE(recorder.pathsChanges[0].second);
+	EXPECT_EQ(recorder.pathsChanges[1].first, model::Path::ListPtr({&m_task->pathAt(2)}));
+	EXPECT_TRUE(recorder.pathsChanges[1].second);
+	EXPECT_EQ(recorder.sizes, std::vector<int>({2}));
+}
+
+TEST_F(ExporterFixture, shouldNotifyPathToggledManyTimesOnce)
+{
+	createTaskFromPolylines(createLines(2));
+
+	SelectionRecorder recorder(*m_task);
+	m_task->batchSelectionChange([this](){
+		for (int i = 0; i < 3; ++i) {
+			m_task->pathAt(0).toggleSelect();
+			m_task->pathAt(1).toggleSelect();
+		}
+		m_task->pathAt(1).toggleSelect();
+	});
+
+	ASSERT_EQ(recorder.pathsChanges.size(), 1);
+	EXPECT_EQ(recorder.pathsChanges[0].first, model::Path::ListPtr({&m_task->pathAt(0)}));
+	EXPECT_TRUE(recorder.pathsChanges[0].second);
+	EXPECT_EQ(recorder.sizes, std::vector<int>({1}));
+}
+
+TEST_F(ExporterFixture, shouldEndSelectionBatchWhenFunctorThrows)
+{
+	createTaskFromPolylines(createLines(2));
+
+	EXPECT_THROW(m_task->batchSelectionChange([](){ throw std::runtime_error("error"); }), std::runtime_error);
+
+	// Changes after failed batch are notified immediately
+	SelectionRecorder recorder(*m_task);
+	m_task->pathAt(0).setSelected(true);
+
+	EXPECT_EQ(recorder.pathChangeCount, 1);
+	EXPECT_EQ(recorder.sizes, std::vector<int>({1}));
+}
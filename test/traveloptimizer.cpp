@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <geometry/traveloptimizer.h>
+
+#include <random>
+
+static geometry::TravelOptimizer::Item::List randomItems(int count)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(0.0f, 1000.0f);
+
+	geometry::TravelOptimizer::Item::List items;
+	for (int i = 0; i < count; ++i) {
+		const geometry::Vector2D start(distribution(generator), distribution(generator));
+		// Mix closed and open items
+		const geometry::Vector2D end = (i % 2) ? start : start + geometry::Vector2D(distribution(generator), distribution(generator)) / 50.0f;
+		items.push_back({{}, start, end});
+	}
+
+	return items;
+}
+
+TEST(TravelOptimizerTest, shouldReturnPermutation)
+{
+	const geometry::TravelOptimizer::Item::List items = randomItems(500);
+	const geometry::TravelOptimizer optimizer(items, geometry::Vector2D(0, 0), std::chrono::milliseconds(1000));
+
+	geometry::TravelOptimizer::Order order = optimizer.order();
+	std::sort(order.begin(), order.end());
+
+	ASSERT_EQ(items.size(), order.size());
+	for (int i = 0, size = order.size(); i < size; ++i) {
+		EXPECT_EQ(i, order[i]);
+	}
+}
+
+TEST(TravelOptimizerTest, shouldReduceTravel)
+{
+	const geometry::TravelOptimizer::Item::List items = randomItems(2000);
+	const geometry::TravelOptimizer optimizer(items, geometry::Vector2D(0, 0), std::chrono::milliseconds(1000));
+
+	EXPECT_LT(optimizer.optimizedTravel(), optimizer.initialTravel() / 10.0f);
+}
+
+TEST(TravelOptimizerTest, shouldOrderAlignedItems)
+{
+	// Items on a line given in shuffled order
+	geometry::TravelOptimizer::Item::List items;
+	for (const int x : {3, 1, 4, 0, 2}) {
+		items.push_back({{}, geometry::Vector2D(x + 1, 0), geometry::Vector2D(x + 1.5f, 0)});
+	}
+
+	const geometry::TravelOptimizer optimizer(items, geometry::Vector2D(0, 0), std::chrono::milliseconds(1000));
+
+	const geometry::TravelOptimizer::Order expectedOrder{3, 1, 4, 0, 2};
+	EXPECT_EQ(expectedOrder, optimizer.order());
+	EXPECT_FLOAT_EQ(8.5f, optimizer.optimizedTravel());
+}
+
+TEST(TravelOptimizerTest, shouldHandleEmptyItems)
+{
+	const geometry::TravelOptimizer::Item::List items;
+	const geometry::TravelOptimizer optimizer(items, geometry::Vector2D(0, 0), std::chrono::milliseconds(1000));
+
+	EXPECT_TRUE(optimizer.order().empty());
+	EXPECT_FLOAT_EQ(0.0f, optimizer.optimizedTravel());
+}